@@ -39,10 +39,9 @@ Arrow::Arrow(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *paren
   setIcon(0, Utils::QIconCached(iconFile));
 
   //h5 dataset
-  int rows=arrow->getRows();
-  double dt;
-  if(rows>=2) dt=arrow->getRow(1)[0]-arrow->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  if(drawThisPath)
+    initAnimRange();
 
   // read XML
   headLength=arrow->getHeadLength();
@@ -253,7 +252,8 @@ void Arrow::createProperties() {
 double Arrow::update() {
   int frame=MainWindow::getInstance()->getFrame()->getValue();
   // read from hdf5
-  data=arrow->getRow(frame);
+  data.resize(8); // allocates only on the first call
+  blendRow(data.data(), 0, data.size(), readFrame(data.size(), data.data()));
 
   // convert data from referencePoint to toPoint reference
   if(arrow->getReferencePoint()==OpenMBV::Arrow::fromPoint) {
@@ -293,8 +293,9 @@ double Arrow::update() {
 
   // path
   if(arrow->getPath()) {
+    double localData[8];
     for(int i=pathMaxFrameRead+1; i<=frame; i++) {
-      vector<double> localData=arrow->getRow(i);
+      arrow->getRow(i, 8, localData);
       if(localData[4]*localData[4]+localData[5]*localData[5]+localData[6]*localData[6]<1e-10) {
         pathNewLine=true;
         continue;
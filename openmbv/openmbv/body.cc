@@ -30,6 +30,7 @@
 #include <Inventor/nodes/SoLightModel.h>
 #include <Inventor/nodes/SoCamera.h>
 #include <Inventor/actions/SoSearchAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
 #include "SoSpecial.h"
 #include <QMenu>
 #include "mainwindow.h"
@@ -49,7 +50,13 @@ namespace OpenMBVGUI {
 
 map<SoNode*,Body*> Body::bodyMap;
 
-Body::Body(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentItem, SoGroup *soParent, int ind) : Object(obj, parentItem, soParent, ind), shilouetteEdgeFirstCall(true), edgeCalc(nullptr) {
+namespace {
+  // the bounding box of a body is refreshed each this number of frame changes (see ViewBBox)
+  constexpr int viewBBoxInterval=32;
+}
+
+Body::Body(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentItem, SoGroup *soParent, int ind) : Object(obj, parentItem, soParent, ind), shilouetteEdgeFirstCall(true), edgeCalc(nullptr),
+  viewBBox(viewBBoxInterval, bodyMap.size()%viewBBoxInterval) { // distribute the bounding box refreshes over the frames
   body=std::static_pointer_cast<OpenMBV::Body>(obj);
   frameSensor=nullptr;
   shilouetteEdgeFrameSensor=nullptr;
@@ -110,6 +117,7 @@ Body::Body(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentI
   
   // GUI
   // register callback function for shilouette edges
+  connect(&shilouetteEdgeThread, &QThread::finished, this, &Body::shilouetteEdgeFinished);
   shilouetteEdgeFrameSensor=new SoFieldSensor(shilouetteEdgeFrameOrCameraSensorCB, this);
   shilouetteEdgeOrientationSensor=new SoFieldSensor(shilouetteEdgeFrameOrCameraSensorCB, this);
   if(body->getShilouetteEdge()) {
@@ -126,6 +134,12 @@ Body::Body(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentI
 }
 
 Body::~Body() {
+  // cancel and wait for a running shilouette edge calculation and delete its not yet used result
+  shilouetteEdgeGeneration++;
+  shilouetteEdgeThread.wait();
+  if(shilouetteEdgeThread.edgeCalc!=edgeCalc)
+    delete shilouetteEdgeThread.edgeCalc;
+
   // delete scene graph
   SoSearchAction sa;
   sa.setInterest(SoSearchAction::FIRST);
@@ -139,6 +153,8 @@ Body::~Body() {
   delete shilouetteEdgeFrameSensor;
   delete shilouetteEdgeOrientationSensor;
   soOutLineSwitch->unref();
+  if(soSepPath)
+    soSepPath->unref();
 
   // remove from map
   for(auto it=bodyMap.begin(); it!=bodyMap.end(); it++)
@@ -185,19 +201,87 @@ void Body::createProperties() {
 
 void Body::frameSensorCB(void *data, SoSensor*) {
   auto* me=(Body*)data;
-  static double time=0;
-  double newTime=time;
-  if(me->drawThisPath)
-    newTime=me->update();
-  if(!isnan(newTime) && newTime!=time && !me->object->getEnvironment()) { // only on first time change and for environment body's (which have hdf5 data)
-    time=newTime;
-    MainWindow::getInstance()->setTime(time);
+  // the time is shown by MainWindow::frameSensorCB (a skipped or static body does not update)
+  if(!me->drawThisPath)
+    return;
+  if(me->skipUpdate())
+    me->updateSkipped=true;
+  else
+    me->updateInView();
+}
+
+bool Body::skipUpdate() {
+  if(!MainWindow::getInstance()->getSkipInvisibleBodies())
+    return false;
+  if(viewBBox.frameChanged(MainWindow::getInstance()->isAnimationStep()))
+    return false; // update to refresh the bounding box
+  SbVec3f center;
+  if(getViewCenter(center))
+    viewBBox.move(center);
+  return !MainWindow::getInstance()->isInView(viewBBox.getBox());
+}
+
+double Body::updateInView() {
+  // the fields set by update do not notify the scene graph above soSep one by one: notify it once afterwards
+  SbBool notify=soSep->enableNotify(FALSE);
+  updateChanged=true;
+  double t=update();
+  soSep->enableNotify(notify);
+  if(updateChanged)
+    soSep->touch();
+  updateSkipped=false;
+  if(viewBBox.needsRefresh() && MainWindow::getInstance()->getSkipInvisibleBodies()) {
+    if(!soSepPath) {
+      SoSearchAction sa;
+      sa.setInterest(SoSearchAction::FIRST);
+      sa.setNode(soSep);
+      sa.setSearchingAll(true);
+      sa.apply(MainWindow::getInstance()->getSceneRoot());
+      if(!sa.getPath())
+        return t;
+      soSepPath=sa.getPath()->copy();
+      soSepPath->ref();
+    }
+    SoGetBoundingBoxAction *bboxAction=MainWindow::getInstance()->bboxAction;
+    bboxAction->apply(soSepPath);
+    SbVec3f center;
+    bool hasCenter=getViewCenter(center);
+    viewBBox.refresh(bboxAction->getBoundingBox(), hasCenter ? &center : nullptr);
+  }
+  return t;
+}
+
+void Body::updateSkippedInView() {
+  // a box which is not valid for the current frame is refreshed (this updates the body once per frame)
+  for(auto &[node, body] : bodyMap)
+    if(body->updateSkipped && body->drawThisPath) {
+      if(!body->viewBBox.isCurrent())
+        body->viewBBox.reset();
+      if(MainWindow::getInstance()->isInView(body->viewBBox.getBox()))
+        body->updateInView();
+    }
+}
+
+void Body::setStatic(bool s) {
+  if(s==isStatic || !frameSensor)
+    return;
+  isStatic=s;
+  if(isStatic) {
+    updateInView(); // show the (constant) data if the body has skipped an update
+    frameSensor->detach();
+    soSep->renderCaching.setValue(SoSeparator::ON);
+  }
+  else {
+    soSep->renderCaching.setValue(SoSeparator::OFF);
+    frameSensor->attach(MainWindow::getInstance()->getFrame());
+    updateInView();
   }
 }
 
 // number of rows / dt
 void Body::resetAnimRange(int numOfRows, double dt) {
   if(numOfRows>0) {
+    MainWindow::getInstance()->animRangeBodies++;
     bool existFiles=MainWindow::getInstance()->getTimeSlider()->totalMaximum()>0;
     if(numOfRows-1<MainWindow::getInstance()->getTimeSlider()->totalMaximum() || !existFiles) {
       MainWindow::getInstance()->timeSlider->setTotalMaximum(numOfRows-1);
@@ -220,41 +304,108 @@ void Body::resetAnimRange(int numOfRows, double dt) {
   }
 }
 
+void Body::initAnimRange() {
+  auto b=std::static_pointer_cast<OpenMBV::Body>(object);
+  int rows=b->getRows();
+  double time[2]={0, 0};
+  if(rows>=2)
+    b->getColumns(0, 2, 0, 1, time); // read only the time column
+  resetAnimRange(rows, time[1]-time[0]);
+}
+
+double Body::readFrame(int n, double *row) {
+  int frame=MainWindow::getInstance()->getFrame()->getValue();
+  body->getRow(frame, n, row);
+  double fraction=MainWindow::getInstance()->getFrameFraction();
+  if(fraction<=0 || frame>=MainWindow::getInstance()->getTimeSlider()->totalMaximum())
+    return 0;
+  nextRow.resize(n); // allocates only on the first call
+  body->getRow(frame+1, n, nextRow.data());
+  return fraction;
+}
+
+void Body::blendRow(double *row, int first, int n, double fraction) {
+  if(fraction<=0)
+    return;
+  for(int i=first; i<first+n; i++)
+    row[i]+=fraction*(nextRow[i]-row[i]);
+}
+
+void Body::blendCardan(double *row, int first, double fraction) {
+  if(fraction<=0)
+    return;
+  SbRotation r0=Utils::cardan2Rotation(SbVec3f(row[first], row[first+1], row[first+2]));
+  SbRotation r1=Utils::cardan2Rotation(SbVec3f(nextRow[first], nextRow[first+1], nextRow[first+2]));
+  SbVec3f c=Utils::rotation2Cardan(SbRotation::slerp(r0, r1, fraction));
+  for(int i=0; i<3; i++)
+    row[first+i]=c[i];
+}
+
 void Body::shilouetteEdgeFrameOrCameraSensorCB(void *data, SoSensor* sensor) {
   auto *me=(Body*)data;
-  bool preproces=sensor==me->shilouetteEdgeFrameSensor || me->shilouetteEdgeFirstCall;
-  bool shilouetteCalc=sensor==me->shilouetteEdgeFrameSensor || sensor==me->shilouetteEdgeOrientationSensor || me->shilouetteEdgeFirstCall;
+  // a frame change requires a new preprocessing; a camera change only a new shilouette edge calculation
+  if(sensor==me->shilouetteEdgeFrameSensor || me->shilouetteEdgeFirstCall)
+    me->shilouetteEdgePreproces=true;
   me->shilouetteEdgeFirstCall=false;
 
-  SoCoordinate3 *soEdgeCoordOld=nullptr;
-  SoIndexedLineSet *soShilouetteEdgeOld=nullptr;
-  SbVec3f n;
-  if(preproces) { // new preprocessing required: do all except preprocessing and coord exchange
-    soEdgeCoordOld=me->soShilouetteEdgeCoord;
-    int outLineSaved=me->soOutLineSwitch->whichChild.getValue(); // save outline
-    me->soOutLineSwitch->whichChild.setValue(SO_SWITCH_NONE); // disable outline
-    delete me->edgeCalc;
-    me->edgeCalc=new EdgeCalculation(me->soSep, false); // collect edge data
-    me->soOutLineSwitch->whichChild.setValue(outLineSaved); // restore outline
+  // if a calculation is running, only the latest request is started when it has finished (intermediate requests are dropped).
+  // The running calculation is canceled if its result is obsolete: always on a frame change, but on a camera change
+  // only if it does not preprocess (the preprocessed data is still needed for the next request).
+  me->shilouetteEdgePending=true;
+  if(!me->shilouetteEdgeRunning)
+    me->shilouetteEdgeStart();
+  else if(sensor==me->shilouetteEdgeFrameSensor || !me->shilouetteEdgeThread.preproces)
+    me->shilouetteEdgeGeneration++;
+}
+
+void Body::shilouetteEdgeStart() {
+  shilouetteEdgePending=false;
+  SbRotation r=MainWindow::getInstance()->glViewer->getCamera()->orientation.getValue(); // camera orientation
+  r*=((SoSFRotation*)(MainWindow::getInstance()->cameraOrientation->outRotation[0]))->getValue(); // camera orientation relative to "Move Camera with Body"
+  r.multVec(SbVec3f(0,0,-1),shilouetteEdgeThread.n); // a vector normal to the viewport in the world frame
+  if(shilouetteEdgePreproces) { // collect the edge data of the current frame (must be done in this thread) for a new edge calculation
+    int outLineSaved=soOutLineSwitch->whichChild.getValue(); // save outline
+    soOutLineSwitch->whichChild.setValue(SO_SWITCH_NONE); // disable outline
+    shilouetteEdgeThread.edgeCalc=new EdgeCalculation(soSep, false); // collect edge data
+    soOutLineSwitch->whichChild.setValue(outLineSaved); // restore outline
   }
-  if(shilouetteCalc) { // new shilouette edge required: to all except shilouette edge calculation and line set exchange
-    SbRotation r=MainWindow::getInstance()->glViewer->getCamera()->orientation.getValue(); // camera orientation
-    r*=((SoSFRotation*)(MainWindow::getInstance()->cameraOrientation->outRotation[0]))->getValue(); // camera orientation relative to "Move Camera with Body"
-    r.multVec(SbVec3f(0,0,-1),n); // a vector normal to the viewport in the world frame
-    soShilouetteEdgeOld=me->soShilouetteEdge;
+  else // a new view normal: use the current edge calculation
+    shilouetteEdgeThread.edgeCalc=edgeCalc;
+  shilouetteEdgeThread.edgeCalc->setCancelGeneration(&shilouetteEdgeGeneration, shilouetteEdgeGeneration);
+  shilouetteEdgeThread.preproces=shilouetteEdgePreproces;
+  shilouetteEdgePreproces=false;
+  shilouetteEdgeThread.fullName=object->getFullName();
+  shilouetteEdgeRunning=true;
+  shilouetteEdgeThread.start();
+}
+
+void Body::shilouetteEdgeFinished() {
+  shilouetteEdgeRunning=false;
+  EdgeCalculation *ec=shilouetteEdgeThread.edgeCalc;
+  // drop the incomplete result of a canceled calculation and start the newest request at once
+  if(shilouetteEdgeThread.canceled) {
+    if(ec!=edgeCalc)
+      delete ec;
+    if(shilouetteEdgeThread.preproces)
+      shilouetteEdgePreproces=true;
+    shilouetteEdgeStart();
+    return;
   }
-  { // THREAD THIS OUT in further development: preproces and edge calculation
-    if(preproces)
-      me->edgeCalc->preproces(me->object->getFullName(), false); // preproces
-    if(shilouetteCalc)
-      me->edgeCalc->calcShilouetteEdges(n); // calc shilouette edges for normal n
+  // exchange the coords and/or the edges in the scene graph (no shilouette edges exist if the body has no faces)
+  if(shilouetteEdgeThread.hasEdges) {
+    if(shilouetteEdgeThread.preproces)
+      soShilouetteEdgeSep->replaceChild(soShilouetteEdgeCoord, soShilouetteEdgeCoord=ec->getCoordinates()); // replace coords
+    auto &edges=shilouetteEdgeThread.edges;
+    soShilouetteEdge->coordIndex.setValues(0, edges.size(), edges.data());
+    soShilouetteEdge->coordIndex.setNum(edges.size());
   }
-  { // WAIT FOR PREVIOUS THREAD in further development: exchange coord and line set
-    if(preproces)
-      me->soShilouetteEdgeSep->replaceChild(soEdgeCoordOld, me->soShilouetteEdgeCoord=me->edgeCalc->getCoordinates()); // replace coords
-    if(shilouetteCalc)
-      me->soShilouetteEdgeSep->replaceChild(soShilouetteEdgeOld, me->soShilouetteEdge=me->edgeCalc->getShilouetteEdges()); // replace shilouette edges
+  if(ec!=edgeCalc) {
+    delete edgeCalc;
+    edgeCalc=ec;
   }
+  // start the calculation requested while this calculation was running
+  if(shilouetteEdgePending)
+    shilouetteEdgeStart();
 }
 
 }
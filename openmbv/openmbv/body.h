@@ -24,15 +24,19 @@
 #include <Inventor/C/errors/debugerror.h> // workaround a include order bug in Coin-3.1.3
 #include <Inventor/sensors/SoFieldSensor.h>
 #include <QActionGroup>
+#include <QThread>
 #include <Inventor/nodes/SoDrawStyle.h>
 #include <Inventor/nodes/SoScale.h>
 #include <Inventor/nodes/SoTriangleStripSet.h>
 #include <Inventor/nodes/SoCoordinate3.h>
+#include <Inventor/SbBox3f.h>
+#include <Inventor/SoPath.h>
 #include "IndexedTesselationFace.h"
 #include <Inventor/lists/SbVec3fList.h>
 #include <Inventor/nodes/SoIndexedLineSet.h>
 #include "utils.h"
 #include "edgecalculation.h"
+#include "viewbbox.h"
 #include "editors.h"
 
 namespace OpenMBV {
@@ -52,20 +56,73 @@ class Body : public Object {
     SoIndexedLineSet *soShilouetteEdge;
     bool shilouetteEdgeFirstCall;
     EdgeCalculation *edgeCalc;
+    // the shilouette edges are calculated in this thread into edges and exchanged in the scene graph by the GUI thread
+    // if finished (double buffering): the thread never changes a scene graph node
+    class ShilouetteEdgeThread : public QThread {
+      public:
+        EdgeCalculation *edgeCalc { nullptr }; // the edge calculation used by the thread
+        bool preproces { false }; // preproces edgeCalc before calculating the shilouette edges
+        SbVec3f n; // the view normal
+        std::string fullName;
+        std::vector<int> edges; // the result: the coordIndex values of the shilouette edges
+        bool hasEdges { false }; // the result: false if the body has no faces
+        bool canceled { false }; // the result is incomplete since a newer calculation was requested
+      protected:
+        void run() override {
+          canceled=false;
+          if(preproces)
+            edgeCalc->preproces(fullName, false);
+          hasEdges=edgeCalc->calcShilouetteEdges(n, edges);
+          canceled=edgeCalc->isCanceled();
+        }
+    };
+    ShilouetteEdgeThread shilouetteEdgeThread;
+    std::atomic<int> shilouetteEdgeGeneration { 0 }; // incremented to cancel the running calculation
+    bool shilouetteEdgeRunning { false }; // true from the thread start until shilouetteEdgeFinished is called
+    bool shilouetteEdgePending { false }; // a new calculation was requested while the thread was running
+    bool shilouetteEdgePreproces { false }; // the next calculation needs a new preprocessing
+    void shilouetteEdgeStart();
+    void shilouetteEdgeFinished();
     SoFieldSensor *frameSensor;
+    // skipping the update of bodies not in the view (see MainWindow::isInView)
+    ViewBBox viewBBox; // the world bounding box of the body
+    bool updateSkipped { false }; // the body does not show the current frame
+    SoPath *soSepPath { nullptr }; // the path to soSep used to calculate viewBBox
+    bool isStatic { false }; // the data of the body is constant (see setStatic)
+    bool skipUpdate();
+    double updateInView();
   public:
     Body(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentItem, SoGroup *soParent, int ind);
     ~Body() override;
     static void frameSensorCB(void *data, SoSensor*);
-    virtual double update()=0; // return the current time
+    virtual double update()=0; // return the current time (may set updateChanged to false if nothing has changed)
+    // the reference point of the body at the current frame, e.g. its translation, without updating the body
+    // (see ViewBBox; return false if the body has no reference point the whole body moves with)
+    virtual bool getViewCenter(SbVec3f &center) { return false; }
     void resetAnimRange(int numOfRows, double dt);
+    // set the frame range and delta time from the number of rows and the time of the first two rows of the body's data
+    void initAnimRange();
     static std::map<SoNode*,Body*>& getBodyMap() { return bodyMap; }
+    // update all bodies which have skipped the update of the current frame and are now in the view
+    static void updateSkippedInView();
+    // A static body has constant data (see MainWindow::StaticBodyThread): it is updated once and then no longer on
+    // frame changes and the rendering of its scene graph is cached.
+    void setStatic(bool s);
   protected:
     std::shared_ptr<OpenMBV::Body> body;
     SoSwitch *soOutLineSwitch, *soShilouetteEdgeSwitch;
     SoSeparator *soOutLineSep, *soShilouetteEdgeSep;
     static std::map<SoNode*,Body*> bodyMap;
     void createProperties() override;
+    // Read the first n columns of the row of the current frame to row. If the frame is interpolated (see
+    // MainWindow::getFrameFraction) the next row is read to nextRow and its weight is returned, else 0 is returned.
+    double readFrame(int n, double *row);
+    // Blend the columns first to first+n-1 of row linearly with nextRow using the weight fraction of nextRow
+    void blendRow(double *row, int first, int n, double fraction);
+    // Blend the cardan angles in the columns first to first+2 of row with nextRow by a spherical linear interpolation
+    void blendCardan(double *row, int first, double fraction);
+    std::vector<double> nextRow;
+    bool updateChanged { true }; // set to false by update if it has not changed the scene graph (soSep is not touched)
     friend class IndexedTesselationFace;
     friend class MainWindow;
 };
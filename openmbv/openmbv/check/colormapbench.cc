@@ -0,0 +1,96 @@
+#include "config.h"
+#include "colormap.h"
+#include <Inventor/SbVec3f.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace OpenMBVGUI;
+using namespace std;
+
+// Measure the conversion of a FlexibleBody row (x, y, z, color of each vertex position) to the positions and the
+// diffuse and specular colors: with a HSV to RGB conversion per vertex (the former FlexibleBody::update) and with the
+// lookup table of ColorMap (the current FlexibleBody::update).
+// Usage: colormapbench [<number of vertex positions> [<number of frames>]]
+
+namespace {
+
+  void hsvUpdate(const vector<double> &row, double minimalColorValue, double maximalColorValue, float s, float v,
+                 vector<SbVec3f> &points, vector<SbColor> &diffuse, vector<SbColor> &specular) {
+    double m=1/(maximalColorValue-minimalColorValue);
+    for(size_t i=0; i<points.size(); i++) {
+      double col=m*(row[i*4+3]-minimalColorValue);
+      if(col<0) col=0;
+      if(col>1) col=1;
+      double hue=(1-col)*2/3;
+      diffuse[i].setHSVValue(hue, s, v);
+      specular[i].setHSVValue(hue, 0.7*s, v);
+      points[i][0]=row[i*4+0];
+      points[i][1]=row[i*4+1];
+      points[i][2]=row[i*4+2];
+    }
+  }
+
+  void lutUpdate(const vector<double> &row, const ColorMap &cm,
+                 vector<SbVec3f> &points, vector<SbColor> &diffuse, vector<SbColor> &specular) {
+    for(size_t i=0; i<points.size(); i++) {
+      int index=cm.getIndex(row[i*4+3]);
+      diffuse[i]=cm.getDiffuseColor(index);
+      specular[i]=cm.getSpecularColor(index);
+    }
+    for(size_t i=0; i<points.size(); i++)
+      points[i].setValue(row[i*4+0], row[i*4+1], row[i*4+2]);
+  }
+
+  float maxDifference(const vector<SbColor> &a, const vector<SbColor> &b) {
+    float diff=0;
+    for(size_t i=0; i<a.size(); i++)
+      for(int c=0; c<3; c++)
+        diff=max(diff, fabs(a[i][c]-b[i][c]));
+    return diff;
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  int numVP=argc>1 ? stoi(argv[1]) : 200000;
+  int numFrames=argc>2 ? stoi(argv[2]) : 50;
+  const double minimalColorValue=-1, maximalColorValue=1;
+  const float s=1, v=1;
+
+  vector<double> row(numVP*4);
+  for(int i=0; i<numVP; i++) {
+    row[i*4+0]=i*1e-3;
+    row[i*4+1]=sin(i*1e-3);
+    row[i*4+2]=cos(i*1e-3);
+    row[i*4+3]=1.2*sin(i*7e-3); // also exceeds the color range
+  }
+  vector<SbVec3f> points(numVP), hsvPoints(numVP);
+  vector<SbColor> diffuse(numVP), specular(numVP), hsvDiffuse(numVP), hsvSpecular(numVP);
+
+  auto start=chrono::steady_clock::now();
+  for(int f=0; f<numFrames; f++)
+    hsvUpdate(row, minimalColorValue, maximalColorValue, s, v, hsvPoints, hsvDiffuse, hsvSpecular);
+  double hsvTime=chrono::duration<double>(chrono::steady_clock::now()-start).count()/numFrames;
+
+  start=chrono::steady_clock::now();
+  auto cm=ColorMap::get(minimalColorValue, maximalColorValue, s, v);
+  for(int f=0; f<numFrames; f++)
+    lutUpdate(row, *cm, points, diffuse, specular);
+  double lutTime=chrono::duration<double>(chrono::steady_clock::now()-start).count()/numFrames;
+
+  cout<<numVP<<" vertex positions, "<<numFrames<<" frames"<<endl;
+  cout<<"HSV conversion per vertex: "<<hsvTime*1e3<<" ms per frame"<<endl;
+  cout<<"color map lookup table:    "<<lutTime*1e3<<" ms per frame ("<<hsvTime/lutTime<<" times faster)"<<endl;
+  // the difference is the quantization of the color value to ColorMap::size entries
+  cout<<"max. color difference: diffuse "<<maxDifference(diffuse, hsvDiffuse)
+      <<", specular "<<maxDifference(specular, hsvSpecular)<<endl;
+  for(int i=0; i<numVP; i++)
+    if(points[i]!=hsvPoints[i]) {
+      cout<<"position "<<i<<" differs"<<endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include "config.h"
+#include "viewbbox.h"
+#include <Inventor/SbViewVolume.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using namespace OpenMBVGUI;
+using namespace std;
+
+// Check that a body skipped by its ViewBBox is never visible: a rotating rigid body (a rod) moves out of the view and
+// back during an animation and at frame jumps (e.g. using the time slider). A body without a reference point must be
+// refreshed at each frame jump.
+
+namespace {
+
+  constexpr int numFrames=400;
+  constexpr int refreshInterval=32;
+
+  // the reference point and the bounding box of the rod at frame f: it moves along x out of the view on both sides
+  SbVec3f center(int f) {
+    return SbVec3f(30*sin(2*M_PI*f/numFrames), 0, -10);
+  }
+  SbBox3f bbox(int f) {
+    SbVec3f c=center(f);
+    double a=0.1*f;
+    SbVec3f tip=c+SbVec3f(2*cos(a), 2*sin(a), 0);
+    SbBox3f box(c, c);
+    box.extendBy(tip);
+    return box;
+  }
+
+  // show frame f: returns the number of errors (the body is skipped but visible)
+  int show(ViewBBox &viewBBox, const SbViewVolume &vv, int f, bool animationStep, int &skipped) {
+    if(viewBBox.frameChanged(animationStep)) {
+      SbVec3f c=center(f);
+      viewBBox.refresh(bbox(f), &c); // the update of the body
+      return 0;
+    }
+    viewBBox.move(center(f));
+    if(vv.intersect(viewBBox.getBox()))
+      return 0;
+    skipped++;
+    if(vv.intersect(bbox(f))) {
+      cout<<"frame "<<f<<": the body is visible but skipped"<<endl;
+      return 1;
+    }
+    return 0;
+  }
+
+}
+
+int main() {
+  SbViewVolume vv;
+  vv.ortho(-5, 5, -5, 5, 1, 100);
+  int errors=0;
+
+  // animation
+  ViewBBox anim(refreshInterval);
+  int animSkipped=0;
+  for(int f=0; f<numFrames; f++)
+    errors+=show(anim, vv, f, true, animSkipped);
+
+  // frame jumps
+  ViewBBox jump(refreshInterval);
+  int jumpSkipped=0;
+  srand(1);
+  for(int i=0; i<numFrames; i++)
+    errors+=show(jump, vv, rand()%numFrames, false, jumpSkipped);
+
+  // most frames outside of the view are skipped (the body is in the view about one third of the frames)
+  if(animSkipped<numFrames/3 || jumpSkipped<numFrames/3) {
+    cout<<"too few frames skipped: animation "<<animSkipped<<", jumps "<<jumpSkipped<<endl;
+    errors++;
+  }
+
+  // a body without a reference point needs a refresh at a frame jump, e.g. back into the view
+  ViewBBox noCenter(refreshInterval);
+  if(!noCenter.frameChanged(true)) {
+    cout<<"no first refresh"<<endl;
+    errors++;
+  }
+  noCenter.refresh(bbox(numFrames/4));
+  if(noCenter.frameChanged(true) || noCenter.isCurrent() || !noCenter.frameChanged(false)) {
+    cout<<"wrong refresh at a frame jump of a body without a reference point"<<endl;
+    errors++;
+  }
+  noCenter.refresh(bbox(0));
+  noCenter.reset();
+  if(!noCenter.getBox().isEmpty() || !noCenter.needsRefresh()) {
+    cout<<"wrong reset"<<endl;
+    errors++;
+  }
+
+  cout<<"skipped frames: animation "<<animSkipped<<", jumps "<<jumpSkipped<<endl;
+  cout<<(errors==0 ? "OK" : "FAILED")<<endl;
+  return errors==0 ? 0 : 1;
+}
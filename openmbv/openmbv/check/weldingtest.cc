@@ -0,0 +1,108 @@
+#include "config.h"
+#include "edgecalculation.h"
+#include <Inventor/SoDB.h>
+#include <Inventor/nodes/SoSeparator.h>
+#include <Inventor/nodes/SoCoordinate3.h>
+#include <Inventor/nodes/SoIndexedFaceSet.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace OpenMBVGUI;
+using namespace std;
+
+// Check that the vertex and edge welding of EdgeCalculation using a hash table (VertexWelding::hashTable; sequential for
+// small and parallel for large meshes if more than one core exists) gives the same coordinates and edges as using a
+// ordered map (VertexWelding::orderedMap) and print the preprocessing time of both.
+// Usage: weldingtest [<number of grid cells per direction of the large mesh>]
+
+namespace {
+
+  // a height field on a n x n grid, each cell is split into two triangles; the random heights give crease edges
+  SoSeparator* createMesh(int n) {
+    auto *sep=new SoSeparator;
+    sep->ref();
+    auto *coord=new SoCoordinate3;
+    sep->addChild(coord);
+    coord->point.setNum((n+1)*(n+1));
+    SbVec3f *p=coord->point.startEditing();
+    unsigned int seed=1;
+    for(int y=0; y<=n; y++)
+      for(int x=0; x<=n; x++) {
+        seed=seed*1103515245+12345;
+        p[y*(n+1)+x].setValue(x, y, (seed>>16)%100*0.01);
+      }
+    coord->point.finishEditing();
+    auto *faceSet=new SoIndexedFaceSet;
+    sep->addChild(faceSet);
+    faceSet->coordIndex.setNum(n*n*8);
+    int32_t *ci=faceSet->coordIndex.startEditing();
+    for(int y=0; y<n; y++)
+      for(int x=0; x<n; x++) {
+        int32_t i=y*(n+1)+x;
+        int32_t *c=&ci[(y*n+x)*8];
+        c[0]=i; c[1]=i+1;   c[2]=i+n+2; c[3]=-1;
+        c[4]=i; c[5]=i+n+2; c[6]=i+n+1; c[7]=-1;
+      }
+    faceSet->coordIndex.finishEditing();
+    return sep;
+  }
+
+  struct Result {
+    double time;
+    vector<SbVec3f> coord;
+    vector<int> crease, boundary, shilouette;
+    bool operator==(const Result &r) const {
+      return coord==r.coord && crease==r.crease && boundary==r.boundary && shilouette==r.shilouette;
+    }
+  };
+
+  Result weld(SoSeparator *mesh, EdgeCalculation::VertexWelding welding) {
+    EdgeCalculation::setVertexWelding(welding);
+    EdgeCalculation ec(mesh, false);
+    Result r;
+    auto start=chrono::steady_clock::now();
+    ec.preproces("mesh");
+    r.time=chrono::duration<double>(chrono::steady_clock::now()-start).count();
+
+    ec.calcCreaseEdges(0.3);
+    ec.calcBoundaryEdges();
+    ec.calcShilouetteEdges(SbVec3f(0.3, 0.4, -0.866), r.shilouette);
+    SoCoordinate3 *coord=ec.getCoordinates();
+    r.coord.assign(coord->point.getValues(0), coord->point.getValues(0)+coord->point.getNum());
+    SoIndexedLineSet *crease=ec.getCreaseEdges();
+    r.crease.assign(crease->coordIndex.getValues(0), crease->coordIndex.getValues(0)+crease->coordIndex.getNum());
+    SoIndexedLineSet *boundary=ec.getBoundaryEdges();
+    boundary->ref();
+    r.boundary.assign(boundary->coordIndex.getValues(0), boundary->coordIndex.getValues(0)+boundary->coordIndex.getNum());
+    boundary->unref();
+    return r;
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  SoDB::init();
+  int n=argc>1 ? stoi(argv[1]) : 200;
+
+  bool ok=true;
+  for(int cells : {20, n}) {
+    SoSeparator *mesh=createMesh(cells);
+    Result orderedMap=weld(mesh, EdgeCalculation::VertexWelding::orderedMap);
+    Result hashTable=weld(mesh, EdgeCalculation::VertexWelding::hashTable);
+    mesh->unref();
+    cout<<2*cells*cells<<" triangles: ordered map "<<orderedMap.time*1e3<<" ms, hash table "<<hashTable.time*1e3<<" ms, "
+        <<orderedMap.coord.size()<<" vertices, "<<orderedMap.crease.size()/3<<" crease, "<<orderedMap.boundary.size()/3
+        <<" boundary and "<<orderedMap.shilouette.size()/3<<" shilouette edges"<<endl;
+    if(orderedMap.coord.size()!=static_cast<size_t>((cells+1)*(cells+1)) || orderedMap.boundary.size()!=static_cast<size_t>(3*4*cells)) {
+      cout<<"wrong welding using the ordered map"<<endl;
+      ok=false;
+    }
+    if(!(hashTable==orderedMap)) {
+      cout<<"the hash table gives a different result than the ordered map"<<endl;
+      ok=false;
+    }
+  }
+  return ok ? 0 : 1;
+}
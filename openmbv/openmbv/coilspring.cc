@@ -36,10 +36,9 @@ CoilSpring::CoilSpring(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetI
   setIcon(0, Utils::QIconCached(iconFile));
 
   //h5 dataset
-  int rows=coilSpring->getRows();
-  double dt;
-  if(rows>=2) dt=coilSpring->getRow(1)[0]-coilSpring->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  if(drawThisPath)
+    initAnimRange();
 
   double R=coilSpring->getSpringRadius();
   double r=coilSpring->getCrossSectionRadius();
@@ -208,8 +207,8 @@ QString CoilSpring::getInfo() {
 
 double CoilSpring::update() {
   // read from hdf5
-  int frame=MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data=coilSpring->getRow(frame);
+  double data[8];
+  blendRow(data, 0, 8, readFrame(8, data));
 
   // translation / rotation
   fromPoint->translation.setValue(data[1],data[2],data[3]);
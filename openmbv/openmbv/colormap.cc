@@ -0,0 +1,57 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "config.h"
+#include "colormap.h"
+#include <map>
+#include <tuple>
+
+using namespace std;
+
+namespace OpenMBVGUI {
+
+shared_ptr<const ColorMap> ColorMap::get(double minimalColorValue, double maximalColorValue, float saturation, float value) {
+  // all color maps in use; a color map is deleted if no body uses it anymore
+  static map<tuple<double, double, float, float>, weak_ptr<const ColorMap>> colorMaps;
+
+  auto key=make_tuple(minimalColorValue, maximalColorValue, saturation, value);
+  auto it=colorMaps.find(key);
+  if(it!=colorMaps.end())
+    if(auto colorMap=it->second.lock())
+      return colorMap;
+
+  // remove unused color maps and create a new one
+  for(auto it=colorMaps.begin(); it!=colorMaps.end();)
+    it=it->second.expired() ? colorMaps.erase(it) : next(it);
+  auto colorMap=make_shared<const ColorMap>(minimalColorValue, maximalColorValue, saturation, value);
+  colorMaps[key]=colorMap;
+  return colorMap;
+}
+
+ColorMap::ColorMap(double minimalColorValue_, double maximalColorValue_, float saturation_, float value_) :
+  minimalColorValue(minimalColorValue_), maximalColorValue(maximalColorValue_), saturation(saturation_), value(value_),
+  m((size-1)/(maximalColorValue-minimalColorValue)), diffuse(size), specular(size) {
+  for(int i=0; i<size; i++) {
+    double hue=(1-static_cast<double>(i)/(size-1))*2/3;
+    diffuse[i].setHSVValue(hue, saturation, value);
+    specular[i].setHSVValue(hue, 0.7*saturation, value);
+  }
+}
+
+}
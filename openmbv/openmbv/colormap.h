@@ -0,0 +1,71 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#ifndef _OPENMBVGUI_COLORMAP_H_
+#define _OPENMBVGUI_COLORMAP_H_
+
+#include <Inventor/SbColor.h>
+#include <vector>
+#include <memory>
+
+namespace OpenMBVGUI {
+
+/** A quantized lookup table of the colors of dynamic colored bodies.
+ * A color value is mapped linearly from [minimalColorValue, maximalColorValue] to the hue [2/3, 0] (blue to red).
+ * The diffuse color (with saturation s and value v) and the specular color (with saturation 0.7*s and value v)
+ * of each hue are precomputed, hence no HSV to RGB conversion is needed at runtime.
+ * Color maps are shared by all bodies using the same parameters, see get.
+ */
+class ColorMap {
+  public:
+    //! number of entries of the lookup table
+    static constexpr int size=1024;
+
+    /** Get the (shared) color map for the given parameters. */
+    static std::shared_ptr<const ColorMap> get(double minimalColorValue, double maximalColorValue, float saturation, float value);
+
+    //! use get to create a shared color map
+    ColorMap(double minimalColorValue_, double maximalColorValue_, float saturation_, float value_);
+
+    //! Returns true if this color map was created with the given parameters.
+    bool isFor(double minimalColorValue_, double maximalColorValue_, float saturation_, float value_) const {
+      return minimalColorValue_==minimalColorValue && maximalColorValue_==maximalColorValue &&
+             saturation_==saturation && value_==value;
+    }
+
+    //! Returns the index in the lookup table of the color value col (values outside the range are clamped).
+    int getIndex(double col) const {
+      double x=m*(col-minimalColorValue);
+      x = x>0 ? (x<size-1 ? x : size-1) : 0; // also maps NaN to 0
+      return static_cast<int>(x+0.5);
+    }
+
+    const SbColor& getDiffuseColor(int index) const { return diffuse[index]; }
+    const SbColor& getSpecularColor(int index) const { return specular[index]; }
+
+  private:
+    double minimalColorValue, maximalColorValue;
+    float saturation, value;
+    double m;
+    std::vector<SbColor> diffuse, specular;
+};
+
+}
+
+#endif
@@ -107,18 +107,19 @@ void CompoundRigidBody::newRigidBodySlot() {
 }
 
 double CompoundRigidBody::update() {
-  if(rigidBody->getRows()==0) return 0; // do nothing for environement objects
+  if(rigidBody->getRows()==0) { updateChanged=false; return 0; } // do nothing for environement objects
 
   // call the normal update for a RigidBody
   double t=RigidBody::update();
 
   // update the color for children
   int frame=MainWindow::getInstance()->getFrame()->getValue();
-  vector<double> data=rigidBody->getRow(frame);
+  double data[8];
+  rigidBody->getRow(frame, 8, data);
   for(int i=0; i<childCount(); i++) {
     auto *childRB=static_cast<RigidBody*>(child(i));
     if(childRB->diffuseColor[0]<0)
-      childRB->setColor(data[7]);
+      updateChanged|=childRB->setColor(data[7]);
   }
 
   return t;
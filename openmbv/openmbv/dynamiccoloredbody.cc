@@ -74,26 +74,26 @@ void DynamicColoredBody::createProperties() {
   }
 }
 
-void DynamicColoredBody::setColor(double col) {
-  if(oldColor!=col) {
-    color=col;
-    oldColor=col;
-    double m=1/(maximalColorValue-minimalColorValue);
-    col=m*col-m*minimalColorValue;
-    if(col<0) col=0;
-    if(col>1) col=1;
-    setHueColor((1-col)*2/3);
-  }
+bool DynamicColoredBody::setColor(double col) {
+  if(oldColor==col)
+    return false;
+  color=col;
+  oldColor=col;
+  const ColorMap &cm=getColorMap();
+  int index=cm.getIndex(col);
+  if(baseColor)
+    baseColor->rgb.setValue(cm.getDiffuseColor(index));
+  mat->diffuseColor.setValue(cm.getDiffuseColor(index));
+  mat->specularColor.setValue(cm.getSpecularColor(index));
+  return true;
 }
 
-void DynamicColoredBody::setHueColor(double hue) {
-  float h, s, v;
-  baseColor->rgb[0].getHSVValue(h, s, v);
-  baseColor->rgb.setHSVValue(hue, s, v);
-  mat->diffuseColor[0].getHSVValue(h, s, v);
-  mat->diffuseColor.setHSVValue(hue, s, v);
-  mat->specularColor[0].getHSVValue(h, s, v);
-  mat->specularColor.setHSVValue(hue, s, v);
+const ColorMap& DynamicColoredBody::getColorMap() {
+  // the saturation and value are taken from the XML diffuse color (as in the constructor) and not from the current
+  // material color since the latter may differ slightly due to rounding which would create a new color map
+  if(!colorMap || !colorMap->isFor(minimalColorValue, maximalColorValue, diffuseColor[1], diffuseColor[2]))
+    colorMap=ColorMap::get(minimalColorValue, maximalColorValue, diffuseColor[1], diffuseColor[2]);
+  return *colorMap;
 }
 
 QString DynamicColoredBody::getInfo() {
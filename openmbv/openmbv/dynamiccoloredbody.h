@@ -25,6 +25,7 @@
 #include <Inventor/nodes/SoMaterial.h>
 #include <Inventor/nodes/SoBaseColor.h>
 #include "editors.h"
+#include "colormap.h"
 
 namespace OpenMBV {
   class DynamicColoredBody;
@@ -37,11 +38,13 @@ class DynamicColoredBody : public Body {
   protected:
     double minimalColorValue, maximalColorValue;
     SoMaterial *mat;
-    SoBaseColor *baseColor;
+    SoBaseColor *baseColor { nullptr };
     std::vector<double> diffuseColor;
     double color,oldColor;
-    void setColor(double col);
-    void setHueColor(double hue);
+    bool setColor(double col); // returns true if the color has changed
+    // the color map of this body (for the color value range and the saturation and value of the diffuse color)
+    std::shared_ptr<const ColorMap> colorMap;
+    const ColorMap& getColorMap();
     double getColor() { return color; }
     std::shared_ptr<OpenMBV::DynamicColoredBody> dcb;
     void createProperties() override;
@@ -44,6 +44,7 @@ DynamicNurbsCurve::DynamicNurbsCurve(const std::shared_ptr<OpenMBV::Object> &obj
   vector<vector<double> > cp = nurbscurve->getControlPoints();
 
   points = new SoCoordinate4;
+  data.resize(1+5*nurbscurve->getNumberOfControlPoints());
 
   vector<double> knot = nurbscurve->getKnotVector();
   float u[knot.size()];
@@ -62,27 +63,30 @@ DynamicNurbsCurve::DynamicNurbsCurve(const std::shared_ptr<OpenMBV::Object> &obj
 
 double DynamicNurbsCurve::update() {
   int frame = MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data = nurbscurve->getRow(frame);
+  nurbscurve->getRow(frame, data.size(), data.data());
 
   SbColor *colorData = mat->diffuseColor.startEditing();
   SbColor *specData = mat->specularColor.startEditing();
-  float h, s, v;
-  mat->diffuseColor[0].getHSVValue(h, s, v);
-  double m=1/(maximalColorValue-minimalColorValue);
+  // use the color map for color values or a constant color for a constant hue
+  const ColorMap *cm = diffuseColor[0]<0 ? &getColorMap() : nullptr;
+  SbColor diffuse, specular;
+  if(!cm) {
+    diffuse.setHSVValue(diffuseColor[0], diffuseColor[1], diffuseColor[2]);
+    specular.setHSVValue(diffuseColor[0], 0.7*diffuseColor[1], diffuseColor[2]);
+  }
 
   points->point.setNum(nurbscurve->getNumberOfControlPoints());
   SbVec4f *pointData = points->point.startEditing();
   for (int i=0; i<nurbscurve->getNumberOfControlPoints(); i++) {
-    double hue = diffuseColor[0];
-    if(hue<0) {
-    double col = data[i*5+5];
-    col = m*(col-minimalColorValue);
-    if(col<0) col=0;
-    if(col>1) col=1;
-    hue = (1-col)*2/3;
+    if(cm) {
+      int index = cm->getIndex(data[i*5+5]);
+      colorData[i] = cm->getDiffuseColor(index);
+      specData[i] = cm->getSpecularColor(index);
+    }
+    else {
+      colorData[i] = diffuse;
+      specData[i] = specular;
     }
-    colorData[i].setHSVValue(hue, s, v);
-    specData[i].setHSVValue(hue, 0.7*s, v);
     pointData[i][0] = data[i*5+1];
     pointData[i][1] = data[i*5+2];
     pointData[i][2] = data[i*5+3];
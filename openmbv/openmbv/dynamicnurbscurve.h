@@ -38,6 +38,7 @@ class DynamicNurbsCurve : public DynamicColoredBody {
   protected:
     std::shared_ptr<OpenMBV::DynamicNurbsCurve> nurbscurve;
     SoCoordinate4 *points;
+    std::vector<double> data; // buffer for the current row, reused on each update
     double update() override;
 };
 
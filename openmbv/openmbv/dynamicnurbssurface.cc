@@ -44,6 +44,7 @@ DynamicNurbsSurface::DynamicNurbsSurface(const std::shared_ptr<OpenMBV::Object>
   vector<vector<double> > cp = nurbssurface->getControlPoints();
 
   points = new SoCoordinate4;
+  data.resize(1+5*nurbssurface->getNumberOfUControlPoints()*nurbssurface->getNumberOfVControlPoints());
 
   vector<double> uKnot = nurbssurface->getUKnotVector();
   float u[uKnot.size()];
@@ -69,27 +70,30 @@ DynamicNurbsSurface::DynamicNurbsSurface(const std::shared_ptr<OpenMBV::Object>
 
 double DynamicNurbsSurface::update() {
   int frame = MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data = nurbssurface->getRow(frame);
+  nurbssurface->getRow(frame, data.size(), data.data());
 
   SbColor *colorData = mat->diffuseColor.startEditing();
   SbColor *specData = mat->specularColor.startEditing();
-  float h, s, v;
-  mat->diffuseColor[0].getHSVValue(h, s, v);
-  double m=1/(maximalColorValue-minimalColorValue);
+  // use the color map for color values or a constant color for a constant hue
+  const ColorMap *cm = diffuseColor[0]<0 ? &getColorMap() : nullptr;
+  SbColor diffuse, specular;
+  if(!cm) {
+    diffuse.setHSVValue(diffuseColor[0], diffuseColor[1], diffuseColor[2]);
+    specular.setHSVValue(diffuseColor[0], 0.7*diffuseColor[1], diffuseColor[2]);
+  }
 
   points->point.setNum(nurbssurface->getNumberOfUControlPoints()*nurbssurface->getNumberOfVControlPoints());
   SbVec4f *pointData = points->point.startEditing();
   for (int i=0; i<nurbssurface->getNumberOfUControlPoints()*nurbssurface->getNumberOfVControlPoints(); i++) {
-    double hue = diffuseColor[0];
-    if(hue<0) {
-    double col = data[i*5+5];
-    col = m*(col-minimalColorValue);
-    if(col<0) col=0;
-    if(col>1) col=1;
-    hue = (1-col)*2/3;
+    if(cm) {
+      int index = cm->getIndex(data[i*5+5]);
+      colorData[i] = cm->getDiffuseColor(index);
+      specData[i] = cm->getSpecularColor(index);
+    }
+    else {
+      colorData[i] = diffuse;
+      specData[i] = specular;
     }
-    colorData[i].setHSVValue(hue, s, v);
-    specData[i].setHSVValue(hue, 0.7*s, v);
     pointData[i][0] = data[i*5+1];
     pointData[i][1] = data[i*5+2];
     pointData[i][2] = data[i*5+3];
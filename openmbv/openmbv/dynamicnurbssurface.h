@@ -38,6 +38,7 @@ class DynamicNurbsSurface : public DynamicColoredBody {
   protected:
     std::shared_ptr<OpenMBV::DynamicNurbsSurface> nurbssurface;
     SoCoordinate4 *points;
+    std::vector<double> data; // buffer for the current row, reused on each update
     double update() override;
 };
 
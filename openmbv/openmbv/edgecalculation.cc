@@ -27,13 +27,29 @@
 #include <iostream>
 #include <map>
 #include <QSemaphore>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <cstring>
+#include <cstdint>
 #include <QThread>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+#include <functional>
 
 using namespace std;
 
 namespace OpenMBVGUI {
 
 map<EdgeCalculation::SoDeleteGroup, EdgeCalculation::PreprocessedDataDelete> EdgeCalculation::edgeCache;
+atomic<EdgeCalculation::VertexWelding> EdgeCalculation::vertexWelding{EdgeCalculation::VertexWelding::hashTable};
+atomic<size_t> EdgeCalculation::diskCacheSize{0};
 
 // HELPER CLASSES
 
@@ -119,18 +135,180 @@ class BSPTree {
     Element *index2Ele;
 };
 
-// SoCoordinate3 which used the SbVec3f data from a BSPTree as points.
-// The BSPTree is delete if the this object is deleted.
-class SoCoordinate3FromBSPTree : public SoCoordinate3 {
+// hash and equal function of SbVec3f objects (equal as defined by SbVec3fComp)
+class SbVec3fHash {
   public:
-    void init(const shared_ptr<BSPTree<SbVec3f, SbVec3fComp>> &bsp_) {
-      if(bsp)
+    size_t operator()(const SbVec3f& a) const {
+      size_t h=0;
+      for(int i=0; i<3; i++) {
+        float x=a[i]+0.0f; // -0 to +0 since both are equal
+        uint32_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        h=(h^bits)*0x100000001b3ull;
+      }
+      return h^(h>>29);
+    }
+    bool equal(const SbVec3f& a, const SbVec3f& b) const {
+      return a[0]==b[0] && a[1]==b[1] && a[2]==b[2];
+    }
+};
+
+// hash and equal function of SbVec2i32 objects
+class SbVec2i32Hash {
+  public:
+    size_t operator()(const SbVec2i32& a) const {
+      size_t h=(static_cast<size_t>(static_cast<uint32_t>(a[0]))<<32) | static_cast<uint32_t>(a[1]);
+      h*=0x9e3779b97f4a7c15ull;
+      return h^(h>>29);
+    }
+    bool equal(const SbVec2i32& a, const SbVec2i32& b) const {
+      return a[0]==b[0] && a[1]==b[1];
+    }
+};
+
+// A replacement of BSPTree using a open addressing hash table (linear probing) instead of a std::map.
+// The elements are stored in a contiguous array in the order of insertion, the table only stores the index in this array.
+// Element: the element to be stored
+// ElementHash: A class with size_t ElementHash::operator()(const Element& a) and bool ElementHash::equal(const Element& a, const Element& b)
+template<class Element, class ElementHash>
+class HashTree {
+  public:
+    HashTree(ElementHash hash_=ElementHash()) : hash(hash_), table(1024, -1) {}
+    // add e to the hash table an return the index of e
+    unsigned int addPoint(const Element& e) {
+      if(2*(ele.size()+1)>table.size()) // keep the load factor below 0.5
+        rehash(2*table.size());
+      size_t mask=table.size()-1;
+      for(size_t i=hash(e)&mask;; i=(i+1)&mask) {
+        if(table[i]<0) {
+          table[i]=ele.size();
+          ele.push_back(e);
+          return table[i];
+        }
+        if(hash.equal(ele[table[i]], e))
+          return table[i];
+      }
+    }
+    // get number of points
+    unsigned int numPoints() {
+      return ele.size();
+    }
+    // get a pointer to all vertices sorted by ascendent index.
+    // The returned pointer gets invalid after a furthermore call to addPoint or destructor.
+    Element* getPointsArrayPtr() {
+      return ele.data();
+    }
+  private:
+    ElementHash hash;
+    vector<int> table; // the index in ele or -1 for a empty slot (the size is a power of 2)
+    vector<Element> ele; // all elements sorted by index
+    void rehash(size_t size) {
+      table.assign(size, -1);
+      size_t mask=size-1;
+      for(size_t index=0; index<ele.size(); index++) {
+        size_t i=hash(ele[index])&mask;
+        while(table[i]>=0)
+          i=(i+1)&mask;
+        table[i]=index;
+      }
+    }
+};
+
+// the on disk cache of preprocessed data (see EdgeCalculation::preproces).
+// File format (native byte order): DiskCacheHeader, float coord[numCoord][3], int32 edge[numEdge][3] (vai, vbi, number of fpv),
+// float fpv[numFPV][3] (the fpv of all edges one after the other)
+struct DiskCacheHeader {
+  char magic[8];
+  uint64_t numVertex; // number of (not welded) vertices of the geometry
+  uint64_t hash[2]; // two independent hashes of all vertices (the first one is also used as file name)
+  uint32_t numCoord, numEdge, numFPV, reserved;
+};
+constexpr char diskCacheMagic[8]={'O', 'M', 'B', 'V', 'E', 'D', 'G', '2'};
+
+// get the directory of the on disk cache (empty if no cache directory exists)
+static QString diskCacheDir() {
+  static const QString dir=QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  return dir.isEmpty() ? QString() : dir+"/edgecalculation";
+}
+
+// get the cache file name and the hashes for the geometry vertex (empty if the on disk cache is not used)
+static QString diskCacheFileName(const vector<SbVec3f> &vertex, uint64_t hash[2]) {
+  QString dir=diskCacheDir();
+  if(dir.isEmpty() || EdgeCalculation::getDiskCacheSize()==0)
+    return {};
+  // a 64bit FNV-1a hash of all bytes and a 64bit multiplicative hash of all 32bit words of all vertices: a file is only
+  // used if both hashes and the number of vertices are equal
+  hash[0]=14695981039346656037ull;
+  auto *p=reinterpret_cast<const unsigned char*>(vertex.data());
+  for(size_t i=0; i<vertex.size()*sizeof(SbVec3f); i++)
+    hash[0]=(hash[0]^p[i])*1099511628211ull;
+  hash[1]=0;
+  for(size_t i=0; i<vertex.size()*sizeof(SbVec3f); i+=sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, p+i, sizeof(word));
+    hash[1]=(((hash[1]<<5)|(hash[1]>>59))^word)*0x9e3779b97f4a7c15ull;
+  }
+  return dir+"/"+QString::number(hash[0], 16)+".edges";
+}
+
+// the minimal number of triangles/edges to do the edge calculation in parallel
+constexpr size_t minParallelTriangles=50000;
+// the number of triangles/edges processed between two checks for a canceled calculation
+constexpr size_t cancelCheckInterval=4096;
+
+namespace {
+  class FunctionRunnable : public QRunnable {
+    public:
+      FunctionRunnable(std::function<void()> func_) : func(std::move(func_)) {}
+      void run() override { func(); }
+    private:
+      std::function<void()> func;
+  };
+}
+
+// call func(c) for c=0, ..., n-1 in parallel using the global thread pool of Qt. The pool is shared by all edge
+// calculations, hence the total number of threads is limited even if many bodies are preprocessed at the same time.
+// The calling thread also calls func for all c not yet started by the pool, hence it never waits for a free pool thread
+// (a pool task which starts after all c are taken just returns).
+template<class Func>
+static void parallelFor(size_t n, const Func &func) {
+  struct State {
+    atomic<size_t> next{0};
+    size_t done{0};
+    QMutex mutex;
+    QWaitCondition finished;
+  };
+  auto state=make_shared<State>();
+  // func is only used while the calling thread waits (for all c taken by a pool thread)
+  auto work=[state, &func, n]() {
+    for(size_t c; (c=state->next++)<n;) {
+      func(c);
+      QMutexLocker lock(&state->mutex);
+      if(++state->done==n)
+        state->finished.wakeAll();
+    }
+  };
+  auto *pool=QThreadPool::globalInstance();
+  for(size_t t=1; t<min(n, static_cast<size_t>(max(pool->maxThreadCount(), 1))); t++)
+    pool->start(new FunctionRunnable(work));
+  work();
+  QMutexLocker lock(&state->mutex);
+  while(state->done<n)
+    state->finished.wait(&state->mutex);
+}
+
+// SoCoordinate3 which used the SbVec3f data from a vector as points.
+// The vector is delete if the this object is deleted.
+class SoCoordinate3FromVector : public SoCoordinate3 {
+  public:
+    void init(const shared_ptr<vector<SbVec3f>> &coord_) {
+      if(coord)
         return;
-      bsp=bsp_;
-      point.setValuesPointer(bsp->numPoints(), bsp->getPointsArrayPtr());
+      coord=coord_;
+      point.setValuesPointer(coord->size(), coord->data());
     }
   private:
-    shared_ptr<BSPTree<SbVec3f, SbVec3fComp>> bsp;
+    shared_ptr<vector<SbVec3f>> coord;
 };
 
 
@@ -158,6 +336,7 @@ EdgeCalculation::EdgeCalculation(SoGroup *grp_, bool useCache_) {
   // initialize
   grp=grp_;
   useCache=useCache_;
+  welding=vertexWelding;
   vertex=new vector<SbVec3f>;
   if(useCache) {
     preData.calcLock=new QReadWriteLock; // stored in a global cache => false positive in valgrind
@@ -165,14 +344,14 @@ EdgeCalculation::EdgeCalculation(SoGroup *grp_, bool useCache_) {
   }
   soCreaseEdges=nullptr;
   soBoundaryEdges=nullptr;
-  shilouetteEdges=nullptr;
   // get all triangles
   SoCallbackAction cba;
   cba.addTriangleCallback(SoShape::getClassTypeId(), triangleCB, vertex);
   cba.apply(grp);
 
-  connect(this, &EdgeCalculation::statusBarShowMessage,
-          MainWindow::getInstance()->statusBar(), &QStatusBar::showMessage);
+  if(MainWindow::getInstance()) // no main window exists in the check programs
+    connect(this, &EdgeCalculation::statusBarShowMessage,
+            MainWindow::getInstance()->statusBar(), &QStatusBar::showMessage);
 }
 
 EdgeCalculation::~EdgeCalculation() {
@@ -210,34 +389,30 @@ void EdgeCalculation::preproces(const string &fullName, bool printMessage) {
 
     // CALCULATE
     preData.edgeIndFPV=new vector<EdgeIndexFacePlaneVec>; // is never freed, since the data is cached forever => false positive in valgrind
-    preData.coord=make_shared<BSPTree<SbVec3f, SbVec3fComp>>(SbVec3fComp(0)); // a 3D float space paritioning for all vertex: allocate dynamically, since the points shared by preData.coords
-    preData.soCoord=new SoCoordinate3FromBSPTree();
+    preData.soCoord=new SoCoordinate3FromVector();
     preData.soCoord->ref();
-    BSPTree<SbVec2i32, SbVec2i32Comp> edge; // a 2D interger space paritioning for all edges
-    // build preData.edges struct from vertex
-    for(unsigned int i=0; i<vertex->size()/3; i++) {
-      // get points from vertex vector
-      SbVec3f v1=(*vertex)[3*i+0];
-      SbVec3f v2=(*vertex)[3*i+1];
-      SbVec3f v3=(*vertex)[3*i+2];
-      // add point and get point index
-      unsigned int v1i=preData.coord->addPoint(v1);
-      unsigned int v2i=preData.coord->addPoint(v2);
-      unsigned int v3i=preData.coord->addPoint(v3);
-      // add edge and get edge index
-      #define addEdge(i,j) addPoint(SbVec2i32((i)<(j)?(i):(j),(i)<(j)?(j):(i))) // smaller index first, larger index second
-      unsigned int e1i=edge.addEdge(v1i, v2i);
-      unsigned int e2i=edge.addEdge(v2i, v3i);
-      unsigned int e3i=edge.addEdge(v3i, v1i);
-      #undef addEdge
-      // add vai,vbi,fpv[...]
-      EdgeIndexFacePlaneVec *x;
-      #define expand(ei) if((ei)>=preData.edgeIndFPV->size()) preData.edgeIndFPV->resize((ei)+1);
-      //expand size; get new/current element; set vai;    set vbi;    append fpv;
-      expand(e1i); x=&(*preData.edgeIndFPV)[e1i];  x->vai=v1i; x->vbi=v2i; x->fpv.push_back(v13OrthoTov12(v1, v2, v3));
-      expand(e2i); x=&(*preData.edgeIndFPV)[e2i];  x->vai=v2i; x->vbi=v3i; x->fpv.push_back(v13OrthoTov12(v2, v3, v1));
-      expand(e3i); x=&(*preData.edgeIndFPV)[e3i];  x->vai=v3i; x->vbi=v1i; x->fpv.push_back(v13OrthoTov12(v3, v1, v2));
-      #undef expand
+    // use the on disk cache for cached (static) geometries
+    QString diskCacheFile;
+    uint64_t hash[2]={0, 0};
+    if(useCache)
+      diskCacheFile=diskCacheFileName(*vertex, hash);
+    if(diskCacheFile.isEmpty() || !readDiskCache(diskCacheFile, hash)) {
+      // both data structures give the same result; the hash table is much faster for large models
+      int numThreads=QThreadPool::globalInstance()->maxThreadCount();
+      if(welding==VertexWelding::hashTable && numThreads>1 && vertex->size()/3>=minParallelTriangles)
+        weldParallel(numThreads, fullName, printMessage);
+      else if(welding==VertexWelding::orderedMap) {
+        BSPTree<SbVec3f, SbVec3fComp> coord(SbVec3fComp(0)); // a 3D float space paritioning for all vertex
+        BSPTree<SbVec2i32, SbVec2i32Comp> edge; // a 2D interger space paritioning for all edges
+        weld(coord, edge);
+      }
+      else {
+        HashTree<SbVec3f, SbVec3fHash> coord; // a hash table of all vertex
+        HashTree<SbVec2i32, SbVec2i32Hash> edge; // a hash table of all edges
+        weld(coord, edge);
+      }
+      if(!diskCacheFile.isEmpty())
+        writeDiskCache(diskCacheFile, hash);
     }
     delete vertex; // is no longer required and was allocate in getEdgeData
 
@@ -268,59 +443,274 @@ void EdgeCalculation::preproces(const string &fullName, bool printMessage) {
   mapRWLock.unlock();
 }
 
-void EdgeCalculation::calcCreaseEdges(const double creaseAngle) {
-  if(!preData.coord) return;
+template<class CoordTree, class EdgeTree>
+void EdgeCalculation::weld(CoordTree &coord, EdgeTree &edge) {
+  // build preData.edges struct from vertex
+  for(unsigned int i=0; i<vertex->size()/3; i++) {
+    if(i%cancelCheckInterval==0 && isCanceled())
+      return;
+    // get points from vertex vector
+    SbVec3f v1=(*vertex)[3*i+0];
+    SbVec3f v2=(*vertex)[3*i+1];
+    SbVec3f v3=(*vertex)[3*i+2];
+    // add point and get point index
+    unsigned int v1i=coord.addPoint(v1);
+    unsigned int v2i=coord.addPoint(v2);
+    unsigned int v3i=coord.addPoint(v3);
+    // add edge and get edge index
+    #define addEdge(i,j) addPoint(SbVec2i32((i)<(j)?(i):(j),(i)<(j)?(j):(i))) // smaller index first, larger index second
+    unsigned int e1i=edge.addEdge(v1i, v2i);
+    unsigned int e2i=edge.addEdge(v2i, v3i);
+    unsigned int e3i=edge.addEdge(v3i, v1i);
+    #undef addEdge
+    // add vai,vbi,fpv[...]
+    EdgeIndexFacePlaneVec *x;
+    #define expand(ei) if((ei)>=preData.edgeIndFPV->size()) preData.edgeIndFPV->resize((ei)+1);
+    //expand size; get new/current element; set vai;    set vbi;    append fpv;
+    expand(e1i); x=&(*preData.edgeIndFPV)[e1i];  x->vai=v1i; x->vbi=v2i; x->fpv.push_back(v13OrthoTov12(v1, v2, v3));
+    expand(e2i); x=&(*preData.edgeIndFPV)[e2i];  x->vai=v2i; x->vbi=v3i; x->fpv.push_back(v13OrthoTov12(v2, v3, v1));
+    expand(e3i); x=&(*preData.edgeIndFPV)[e3i];  x->vai=v3i; x->vbi=v1i; x->fpv.push_back(v13OrthoTov12(v3, v1, v2));
+    #undef expand
+  }
+  // the points sorted by index (allocate dynamically, since the points are shared by preData.coord and preData.soCoord)
+  SbVec3f *points=coord.getPointsArrayPtr();
+  preData.coord=make_shared<vector<SbVec3f>>(points, points+coord.numPoints());
+}
 
-  for(auto & i : *preData.edgeIndFPV) {
-    // only draw crease edge if two faces belongs to this edge
-    if(i.fpv.size()==2) {
-      int vai=i.vai; // index of edge start
-      int vbi=i.vbi; // index of edge end
-      // draw crease edge if angle between fpv[0] and fpv[1] is < pi-creaseAngle
-      if(i.fpv[0].dot(i.fpv[1])>-cos(creaseAngle)) {
-        creaseEdges.push_back(vai);
-        creaseEdges.push_back(vbi);
-        creaseEdges.push_back(-1);
-      }
+void EdgeCalculation::weldParallel(int numThreads, const string &fullName, bool printMessage) {
+  // Each thread welds the vertices/edges of a contiguous range of triangles using its own hash table.
+  // The local tables are merged in the order of the ranges which gives exactly the same indices as a sequential welding
+  // (an element gets its index at the first occurrence). Finally all local indices are mapped to the global ones in parallel.
+  QElapsedTimer timer;
+  timer.start();
+  size_t numTri=vertex->size()/3;
+  size_t numChunks=numThreads;
+  auto begin=[numTri, numChunks](size_t c) { return numTri*c/numChunks; };
+
+  // welding of Element's: key(i) is the element of corner i; index[i] gets the global index of this element
+  auto weldElements=[&](auto &global, auto getKey, vector<unsigned int> &index) {
+    using Tree=typename std::remove_reference<decltype(global)>::type;
+    vector<Tree> local(numChunks);
+    parallelFor(numChunks, [&](size_t c) {
+      for(size_t i=3*begin(c); i<3*begin(c+1); i++)
+        index[i]=local[c].addPoint(getKey(i));
+    });
+    if(isCanceled())
+      return;
+    vector<vector<unsigned int>> local2Global(numChunks);
+    for(size_t c=0; c<numChunks; c++) {
+      auto *ele=local[c].getPointsArrayPtr();
+      local2Global[c].resize(local[c].numPoints());
+      for(size_t j=0; j<local2Global[c].size(); j++)
+        local2Global[c][j]=global.addPoint(ele[j]);
     }
+    parallelFor(numChunks, [&](size_t c) {
+      for(size_t i=3*begin(c); i<3*begin(c+1); i++)
+        index[i]=local2Global[c][index[i]];
+    });
+  };
+
+  // vertices
+  HashTree<SbVec3f, SbVec3fHash> coord;
+  vector<unsigned int> vi(3*numTri); // the vertex index of each triangle corner
+  weldElements(coord, [this](size_t i) { return (*vertex)[i]; }, vi);
+  if(isCanceled())
+    return;
+  auto tVertex=timer.restart();
+
+  // edges: edge j of a triangle is from corner j to corner j+1
+  auto next=[](size_t i) { return i-i%3+(i+1)%3; };
+  HashTree<SbVec2i32, SbVec2i32Hash> edge;
+  vector<unsigned int> ei(3*numTri); // the edge index of each triangle edge
+  weldElements(edge, [&vi, &next](size_t i) {
+    unsigned int a=vi[i], b=vi[next(i)];
+    return SbVec2i32(min(a, b), max(a, b)); // smaller index first, larger index second
+  }, ei);
+  if(isCanceled())
+    return;
+  auto tEdge=timer.restart();
+
+  // face plane vectors
+  vector<SbVec3f> fpv(3*numTri);
+  parallelFor(numChunks, [&](size_t c) {
+    for(size_t i=3*begin(c); i<3*begin(c+1); i++)
+      fpv[i]=v13OrthoTov12((*vertex)[i], (*vertex)[next(i)], (*vertex)[next(next(i))]);
+  });
+  preData.edgeIndFPV->resize(edge.numPoints());
+  for(size_t i=0; i<3*numTri; i++) {
+    auto &x=(*preData.edgeIndFPV)[ei[i]];
+    x.vai=vi[i];
+    x.vbi=vi[next(i)];
+    x.fpv.push_back(fpv[i]);
   }
+  SbVec3f *points=coord.getPointsArrayPtr();
+  preData.coord=make_shared<vector<SbVec3f>>(points, points+coord.numPoints());
+  auto tFPV=timer.elapsed();
+
+  if(printMessage)
+    msg(Info)<<"Edge preprocessing of "<<fullName<<" using "<<numThreads<<" pool threads: vertices "<<tVertex<<"ms, edges "<<tEdge
+             <<"ms, face plane vectors "<<tFPV<<"ms"<<endl;
 }
 
-void EdgeCalculation::calcBoundaryEdges() {
-  if(!preData.coord) return;
+void EdgeCalculation::setDiskCacheSize(size_t bytes) {
+  diskCacheSize=bytes;
+  limitDiskCache();
+}
 
-  for(auto & i : *preData.edgeIndFPV) {
-    // draw boundary edge if only one face belongs to this edge
-    if(i.fpv.size()==1) {
-      boundaryEdges.push_back(i.vai);
-      boundaryEdges.push_back(i.vbi);
-      boundaryEdges.push_back(-1);
+void EdgeCalculation::limitDiskCache() {
+  QString dir=diskCacheDir();
+  if(dir.isEmpty())
+    return;
+  // keep the most recently used files which fit into the cache size (the modification time is set on each use)
+  auto files=QDir(dir).entryInfoList({"*.edges"}, QDir::Files, QDir::Time);
+  size_t size=0;
+  for(auto &file : files) {
+    size+=file.size();
+    if(size>diskCacheSize)
+      QFile::remove(file.absoluteFilePath()); // may fail if removed by another thread at the same time
+  }
+}
+
+bool EdgeCalculation::readDiskCache(const QString &fileName, const uint64_t hash[2]) {
+  QFile file(fileName);
+  if(!file.open(QIODevice::ReadOnly))
+    return false;
+  auto size=static_cast<size_t>(file.size());
+  if(size<sizeof(DiskCacheHeader))
+    return false;
+  const uchar *data=file.map(0, size);
+  if(!data)
+    return false;
+  DiskCacheHeader header;
+  memcpy(&header, data, sizeof(header));
+  size_t coordOffset=sizeof(header);
+  size_t edgeOffset=coordOffset+header.numCoord*sizeof(SbVec3f);
+  size_t fpvOffset=edgeOffset+header.numEdge*3*sizeof(int32_t);
+  if(memcmp(header.magic, diskCacheMagic, sizeof(diskCacheMagic))!=0 || header.numVertex!=vertex->size() ||
+     header.hash[0]!=hash[0] || header.hash[1]!=hash[1] || size!=fpvOffset+header.numFPV*sizeof(SbVec3f)) {
+    msg(Debug)<<"Ignoring invalid edge calculation cache file "<<fileName.toStdString()<<endl;
+    return false;
+  }
+
+  auto coord=make_shared<vector<SbVec3f>>(header.numCoord);
+  memcpy(coord->data(), data+coordOffset, header.numCoord*sizeof(SbVec3f));
+  vector<int32_t> edge(3*header.numEdge);
+  memcpy(edge.data(), data+edgeOffset, edge.size()*sizeof(int32_t));
+  auto *fpv=reinterpret_cast<const SbVec3f*>(data+fpvOffset);
+  auto *fpvEnd=fpv+header.numFPV;
+  preData.edgeIndFPV->resize(header.numEdge);
+  for(uint32_t i=0; i<header.numEdge; i++) {
+    auto &x=(*preData.edgeIndFPV)[i];
+    x.vai=edge[3*i+0];
+    x.vbi=edge[3*i+1];
+    if(x.vai<0 || x.vbi<0 || static_cast<uint32_t>(max(x.vai, x.vbi))>=header.numCoord || edge[3*i+2]<0 || fpvEnd-fpv<edge[3*i+2]) {
+      msg(Debug)<<"Ignoring invalid edge calculation cache file "<<fileName.toStdString()<<endl;
+      preData.edgeIndFPV->clear();
+      return false;
     }
+    x.fpv.assign(fpv, fpv+edge[3*i+2]);
+    fpv+=edge[3*i+2];
+  }
+  preData.coord=coord;
+  file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime); // mark as recently used
+  return true;
+}
+
+void EdgeCalculation::writeDiskCache(const QString &fileName, const uint64_t hash[2]) {
+  if(!preData.coord)
+    return;
+  DiskCacheHeader header;
+  memcpy(header.magic, diskCacheMagic, sizeof(diskCacheMagic));
+  header.numVertex=vertex->size();
+  header.hash[0]=hash[0];
+  header.hash[1]=hash[1];
+  header.numCoord=preData.coord->size();
+  header.numEdge=preData.edgeIndFPV->size();
+  header.numFPV=0;
+  header.reserved=0;
+  vector<int32_t> edge;
+  edge.reserve(3*header.numEdge);
+  for(auto &x : *preData.edgeIndFPV) {
+    edge.insert(edge.end(), {x.vai, x.vbi, static_cast<int32_t>(x.fpv.size())});
+    header.numFPV+=x.fpv.size();
+  }
+
+  // write to a temporary file which is renamed on commit: a cache file is always complete (even for concurrent writers)
+  QDir().mkpath(QFileInfo(fileName).path());
+  QSaveFile file(fileName);
+  if(!file.open(QIODevice::WriteOnly)) {
+    msg(Debug)<<"Unable to write edge calculation cache file "<<fileName.toStdString()<<endl;
+    return;
   }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(preData.coord->data()), preData.coord->size()*sizeof(SbVec3f));
+  file.write(reinterpret_cast<const char*>(edge.data()), edge.size()*sizeof(int32_t));
+  for(auto &x : *preData.edgeIndFPV)
+    file.write(reinterpret_cast<const char*>(x.fpv.data()), x.fpv.size()*sizeof(SbVec3f));
+  if(!file.commit()) {
+    msg(Debug)<<"Unable to write edge calculation cache file "<<fileName.toStdString()<<endl;
+    return;
+  }
+  limitDiskCache();
 }
 
-void EdgeCalculation::calcShilouetteEdges(const SbVec3f &n) {
+template<class Pred>
+void EdgeCalculation::classifyEdges(vector<int> &edges, const Pred &pred) {
+  // each thread classifies a contiguous range of edges; the results are appended in order (same result as sequential)
+  auto &edgeIndFPV=*preData.edgeIndFPV;
+  size_t numChunks=edgeIndFPV.size()>=minParallelTriangles ? max(QThreadPool::globalInstance()->maxThreadCount(), 1) : 1;
+  vector<vector<int>> chunkEdges(numChunks);
+  parallelFor(numChunks, [&](size_t c) {
+    size_t first=edgeIndFPV.size()*c/numChunks;
+    for(size_t i=first; i<edgeIndFPV.size()*(c+1)/numChunks; i++) {
+      if((i-first)%cancelCheckInterval==0 && isCanceled())
+        return;
+      if(pred(edgeIndFPV[i]))
+        chunkEdges[c].insert(chunkEdges[c].end(), {edgeIndFPV[i].vai, edgeIndFPV[i].vbi, -1});
+    }
+  });
+  if(isCanceled())
+    return;
+  for(auto &ce : chunkEdges)
+    edges.insert(edges.end(), ce.begin(), ce.end());
+}
+
+void EdgeCalculation::calcCreaseEdges(const double creaseAngle) {
   if(!preData.coord) return;
-  preData.soCoord->init(preData.coord);
 
-  shilouetteEdges=new SoIndexedLineSet;
-  int nr=0;
-  for(auto & i : *preData.edgeIndFPV) {
+  double cosCreaseAngle=cos(creaseAngle);
+  classifyEdges(creaseEdges, [cosCreaseAngle](const EdgeIndexFacePlaneVec &e) {
+    // only draw crease edge if two faces belongs to this edge and
+    // if angle between fpv[0] and fpv[1] is < pi-creaseAngle
+    return e.fpv.size()==2 && e.fpv[0].dot(e.fpv[1])>-cosCreaseAngle;
+  });
+}
+
+void EdgeCalculation::calcBoundaryEdges() {
+  if(!preData.coord) return;
+
+  classifyEdges(boundaryEdges, [](const EdgeIndexFacePlaneVec &e) {
+    // draw boundary edge if only one face belongs to this edge
+    return e.fpv.size()==1;
+  });
+}
+
+bool EdgeCalculation::calcShilouetteEdges(const SbVec3f &n, vector<int> &edges) {
+  edges.clear();
+  if(!preData.coord) return false;
+
+  auto &coord=*preData.coord; // the same data as preData.soCoord->point but can be read from several threads
+  classifyEdges(edges, [&coord, &n](const EdgeIndexFacePlaneVec &e) {
     // only draw shilouette edge if two faces belongs to this edge
-    if(i.fpv.size()==2) {
-      int vai=i.vai; // index of edge start
-      int vbi=i.vbi; // index of edge end
-      SbVec3f v12=preData.soCoord->point[vbi]-preData.soCoord->point[vai]; // edge vector
-      SbVec3f n0=v12.cross(i.fpv[0]); // normal of face 0
-      SbVec3f n1=i.fpv[1].cross(v12); // normal of face 1
-      // draw shilouette edge if the face normals to different screen z directions (one i z+ one in z-)
-      if(n0.dot(n)*n1.dot(n)<=0) {
-        shilouetteEdges->coordIndex.set1Value(nr++, vai);
-        shilouetteEdges->coordIndex.set1Value(nr++, vbi);
-        shilouetteEdges->coordIndex.set1Value(nr++, -1);
-      }
-    }
-  }
+    if(e.fpv.size()!=2)
+      return false;
+    SbVec3f v12=coord[e.vbi]-coord[e.vai]; // edge vector
+    SbVec3f n0=v12.cross(e.fpv[0]); // normal of face 0
+    SbVec3f n1=e.fpv[1].cross(v12); // normal of face 1
+    // draw shilouette edge if the face normals to different screen z directions (one i z+ one in z-)
+    return n0.dot(n)*n1.dot(n)<=0;
+  });
+  return true;
 }
 
 SoCoordinate3* EdgeCalculation::getCoordinates() {
@@ -23,6 +23,7 @@
 #include <fmatvec/atom.h>
 #include <QtCore/QObject>
 #include <vector>
+#include <atomic>
 #include <Inventor/C/errors/debugerror.h> // workaround a include order bug in Coin-3.1.3
 #include <Inventor/nodes/SoCoordinate3.h>
 #include <Inventor/nodes/SoIndexedLineSet.h>
@@ -32,14 +33,24 @@
 namespace OpenMBVGUI {
 
 class MainWindow;
-template<class Element, class ElementComp> class BSPTree;
-class SbVec3fComp;
-class SoCoordinate3FromBSPTree;
+class SoCoordinate3FromVector;
 
 class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
   friend MainWindow;
   Q_OBJECT
   public:
+    /** The data structure used to find equal vertices and edges in preproces */
+    enum class VertexWelding {
+      orderedMap, //!< a std::map: O(log n) per vertex
+      hashTable, //!< a open addressing hash table: O(1) per vertex (default)
+    };
+    /** Set the data structure used by all following calls of preproces (the result is the same for all) */
+    static void setVertexWelding(VertexWelding vw) { vertexWelding=vw; }
+    /** Set the maximal size in bytes of the on disk cache (see preproces); the least recently used files are removed
+     * if the cache gets larger. 0 disables the on disk cache and removes all its files (the default). */
+    static void setDiskCacheSize(size_t bytes);
+    static size_t getDiskCacheSize() { return diskCacheSize; }
+
     /** Collect the data to be edge calculated from grp.
      * This function must be called from the main Coin thread and is very fast.
      * After this function the function preproces must be called exactly ones!
@@ -52,6 +63,8 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
     /** Preproces the data collected with collectData.
      * This function is very time consuming for new data in grp from collectData.
      * For data in grp (in constructor) beeing alreay preprocessed it is cached if cache (in constructor) is true.
+     * If cache is true the result is also stored in a on disk cache (keyed by the geometry) which is used on the next
+     * program start (see setDiskCacheSize).
      * This function is thread safe in all cases!!! */
     void preproces(const std::string &fullName, bool printMessage=false);
 
@@ -66,10 +79,23 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
     void calcBoundaryEdges();
 
     /** calculate the shilouette edges using the given view normal n.
-     * Before this funciton the function preproces must be called exactly ones!
-     * This function is not very time consuming but is thread!!!
+     * The coordIndex values of a line set of the shilouette edges (using the coordinates of getCoordinates) are stored
+     * in edges. Returns false if no shilouette edges exist since no faces exist.
+     * Before this funciton the function preproces must be called (several calls with different n are allowed)!
+     * This function is not very time consuming and does not change this object or its scene graph nodes, hence it
+     * can run in a thread while the coordinates are used in the scene graph.
      * It must be called with the current normal n each time the view rotation changes. */
-    void calcShilouetteEdges(const SbVec3f &n);
+    bool calcShilouetteEdges(const SbVec3f &n, std::vector<int> &edges);
+
+    /** cancel the following calls of preproces and calcShilouetteEdges if *generation_ gets unequal to expected_.
+     * A canceled call returns early (it checks the generation between chunks of work) with an incomplete result
+     * which must not be used (see isCanceled). Only used if useCache is false (cached data is shared). */
+    void setCancelGeneration(const std::atomic<int> *generation_, int expected_) {
+      cancelGeneration=generation_;
+      cancelExpected=expected_;
+    }
+    /** return true if the calculation is canceled (see setCancelGeneration) */
+    bool isCanceled() const { return !useCache && cancelGeneration && *cancelGeneration!=cancelExpected; }
 
     /** return the coordinates used bey get*Edges().
      * Before this funciton the function preproces must be called exactly ones!
@@ -84,8 +110,7 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
       if(!soCreaseEdges) {
         soCreaseEdges=new SoIndexedLineSet;
         soCreaseEdges->ref();
-        for(size_t nr=0; nr<creaseEdges.size(); ++nr)
-          soCreaseEdges->coordIndex.set1Value(nr, creaseEdges[nr]);
+        soCreaseEdges->coordIndex.setValues(0, creaseEdges.size(), creaseEdges.data());
       }
       return soCreaseEdges;
     }
@@ -97,22 +122,18 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
     SoIndexedLineSet* getBoundaryEdges() {
       if(!soBoundaryEdges) {
         soBoundaryEdges=new SoIndexedLineSet;
-        for(size_t nr=0; nr<boundaryEdges.size(); ++nr)
-          soBoundaryEdges->coordIndex.set1Value(nr, boundaryEdges[nr]);
+        soBoundaryEdges->coordIndex.setValues(0, boundaryEdges.size(), boundaryEdges.data());
       }
       return soBoundaryEdges;
     }
 
-    /** return the shilouette edge face-set.
-     * Before this funciton the function calcShilouetteEdges must be called exactly ones!
-     * NOTE: Adding the face-set to the scene graph must be done in the main Cion thread!
-     * The coordinates used by this face-set are the ones return by getCoordinates */
-    SoIndexedLineSet* getShilouetteEdges() {
-      return shilouetteEdges;
-    }
-
   private:
+    static std::atomic<VertexWelding> vertexWelding;
+    static std::atomic<size_t> diskCacheSize;
+    VertexWelding welding; // the value of vertexWelding at construction time (preproces may run in another thread)
     bool useCache;
+    const std::atomic<int> *cancelGeneration { nullptr };
+    int cancelExpected { 0 };
     static void triangleCB(void *data, SoCallbackAction *action, const SoPrimitiveVertex *vp1, const SoPrimitiveVertex *vp2, const SoPrimitiveVertex *vp3);
     static SbVec3f v13OrthoTov12(SbVec3f v1, SbVec3f v2, SbVec3f v3);
 
@@ -128,8 +149,8 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
     struct PreprocessedData { // preprocesses/cached data
 
       // the coordinates for the face-sets (allocated in preproces and never freed, since the cache uses it)
-      std::shared_ptr<BSPTree<SbVec3f, SbVec3fComp>> coord; // coord are push to this class during threaded computation
-      SoCoordinate3FromBSPTree *soCoord=nullptr;
+      std::shared_ptr<std::vector<SbVec3f>> coord; // coord are push to this class during threaded computation
+      SoCoordinate3FromVector *soCoord=nullptr;
 
       std::vector<EdgeIndexFacePlaneVec> *edgeIndFPV=nullptr; // a 1D array for all edges (allocated in preproces and never freed, since the cache uses it)
       QReadWriteLock *calcLock=nullptr; // is write locked until the calculation is running
@@ -143,6 +164,19 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
       ~PreprocessedDataDelete();
     };
     PreprocessedData preData;
+    // find equal vertices and edges of all triangles using CoordTree and EdgeTree and fill preData
+    template<class CoordTree, class EdgeTree>
+    void weld(CoordTree &coord, EdgeTree &edge);
+    // append the start and end index and -1 of all edges for which pred(edge) is true to edges (in parallel for many edges)
+    template<class Pred>
+    void classifyEdges(std::vector<int> &edges, const Pred &pred);
+    // the same as weld with HashTree but using numThreads threads of the global thread pool (the result is the same)
+    void weldParallel(int numThreads, const std::string &fullName, bool printMessage);
+    // read/write preData from/to the on disk cache file fileName for the geometry with the hashes hash (see preproces)
+    bool readDiskCache(const QString &fileName, const uint64_t hash[2]);
+    void writeDiskCache(const QString &fileName, const uint64_t hash[2]);
+    // remove the least recently used files of the on disk cache until the cache fits into diskCacheSize
+    static void limitDiskCache();
     struct SoDeleteGroup {
       SoDeleteGroup(SoGroup *g_) : g(g_) {}
       SoDeleteGroup(const SoDeleteGroup& other) = delete;
@@ -163,9 +197,6 @@ class EdgeCalculation : public QObject, virtual public fmatvec::Atom {
     std::vector<int> boundaryEdges; // boundaryEdges are push to this class during threaded computation
     SoIndexedLineSet *soBoundaryEdges; // after the threaded computation finished boundaryEdges are copied to this class
 
-    // set by calcShilouetteEdges
-    SoIndexedLineSet *shilouetteEdges;
-
   Q_SIGNALS:
     void statusBarShowMessage(const QString &message, int timeout=0);
 };
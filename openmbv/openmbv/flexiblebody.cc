@@ -25,6 +25,7 @@
 #include "openmbvcppinterface/flexiblebody.h"
 #include <QMenu>
 #include <vector>
+#include <algorithm>
 #include <cfloat>
 
 using namespace std;
@@ -42,37 +43,43 @@ FlexibleBody::FlexibleBody(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWid
   points = new SoCoordinate3;
   soSep->addChild(points);
 
+  data.resize(1+4*body->getNumberOfVertexPositions());
+
   // outline
   soSep->addChild(soOutLineSwitch);
 }
 
 double FlexibleBody::update() {
-  int frame = MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data = body->getRow(frame);
+  blendRow(data.data(), 0, data.size(), readFrame(data.size(), data.data()));
+  int numVP=body->getNumberOfVertexPositions();
+  const double *row=data.data()+1; // x, y, z, color of each vertex position
 
   SbColor *colorData = mat->diffuseColor.startEditing();
   SbColor *specData = mat->specularColor.startEditing();
-  float h, s, v;
-  mat->diffuseColor[0].getHSVValue(h, s, v);
-  double m=1/(maximalColorValue-minimalColorValue);
-
-  points->point.setNum(body->getNumberOfVertexPositions());
-  SbVec3f *pointData = points->point.startEditing();
-  for (int i=0; i<body->getNumberOfVertexPositions(); i++) {
-    double hue = diffuseColor[0];
-    if(hue<0) {
-    double col = data[i*4+4];
-    col = m*(col-minimalColorValue);
-    if(col<0) col=0;
-    if(col>1) col=1;
-    hue = (1-col)*2/3;
+  double hue = diffuseColor[0];
+  if(hue<0) {
+    // map the color value using the color map instead of a HSV to RGB conversion per vertex
+    const ColorMap &cm=getColorMap();
+    for (int i=0; i<numVP; i++) {
+      int index = cm.getIndex(row[i*4+3]);
+      colorData[i] = cm.getDiffuseColor(index);
+      specData[i] = cm.getSpecularColor(index);
     }
-    colorData[i].setHSVValue(hue, s, v);
-    specData[i].setHSVValue(hue, 0.7*s, v);
-    pointData[i][0] = data[i*4+1];
-    pointData[i][1] = data[i*4+2];
-    pointData[i][2] = data[i*4+3];
   }
+  else {
+    // a constant hue: all vertices have the same color
+    SbColor diffuse, specular;
+    diffuse.setHSVValue(hue, diffuseColor[1], diffuseColor[2]);
+    specular.setHSVValue(hue, 0.7*diffuseColor[1], diffuseColor[2]);
+    fill_n(colorData, numVP, diffuse);
+    fill_n(specData, numVP, specular);
+  }
+
+  points->point.setNum(numVP);
+  SbVec3f *pointData = points->point.startEditing();
+  // a separate loop with only the (inlined) SbVec3f::setValue calls which the compiler can vectorize
+  for (int i=0; i<numVP; i++)
+    pointData[i].setValue(row[i*4+0], row[i*4+1], row[i*4+2]);
   mat->diffuseColor.finishEditing();
   mat->diffuseColor.setDefault(FALSE);
   mat->specularColor.finishEditing();
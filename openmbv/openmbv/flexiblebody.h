@@ -38,6 +38,7 @@ class FlexibleBody : public DynamicColoredBody {
   protected:
     std::shared_ptr<OpenMBV::FlexibleBody> body;
     SoCoordinate3 *points;
+    std::vector<double> data; // buffer for the current row, reused on each update
     double update() override;
 };
 
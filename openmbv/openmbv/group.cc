@@ -148,7 +148,12 @@ void Group::newObjectSlot() {
 }
 
 void Group::unloadFileSlot() {
+  MainWindow::getInstance()->stopPrefetch(); // the prefetch thread must not read from the HDF5 file closed here
+  MainWindow::getInstance()->stopStaticBodyDetection(); // the same for the static body detection
+  MainWindow::getInstance()->stopTimeIndex(); // and for the time index
   MainWindow::getInstance()->openMBVBodyForLastFrame.reset(); // just required if openMBVBodyForLastFrame stores a pointer to the here removed object
+  MainWindow::getInstance()->timeIndex.clear(); // the index is built again from the new openMBVBodyForLastFrame
+  MainWindow::getInstance()->timeIndexIncreasing=true;
   // deleting an QTreeWidgetItem will remove the item from the tree (this is safe at any time)
   delete this;
 }
@@ -171,7 +176,12 @@ void Group::reloadFileSlot() {
 }
 
 void Group::refreshFileSlot() {
+  MainWindow::getInstance()->stopPrefetch(); // the prefetch thread must not read while the HDF5 file is refreshed
+  MainWindow::getInstance()->stopStaticBodyDetection(); // the same for the static body detection
+  MainWindow::getInstance()->stopTimeIndex(); // and for the time index
   grp->refresh();
+  // new rows may move a static body
+  MainWindow::getInstance()->resetStaticBodies();
 
   // if we are at the first frame we may need to redraw (refresh the scene) since the first frame may
   // also be the ALL NULL position.
@@ -35,6 +35,7 @@
 #include "openmbvcppinterface/group.h"
 
 #include <QMenu>
+#include <QElapsedTimer>
 
 using namespace std;
 
@@ -171,9 +172,16 @@ void IvBody::calculateEdges(const string& fullName, double creaseEdges, bool bou
   QString str("Started edge calculation for %1 in a thread:"); str=str.arg(fullName.c_str());
   statusBarShowMessage(str, 1000);
   msg(Info)<<str.toStdString()<<endl;
+  QElapsedTimer timer;
+  timer.start();
   edgeCalc->preproces(fullName, true);
+  auto tPreproces=timer.restart();
   if(creaseEdges>=0) edgeCalc->calcCreaseEdges(creaseEdges);
+  auto tCrease=timer.restart();
   if(boundaryEdges) edgeCalc->calcBoundaryEdges();
+  auto tBoundary=timer.elapsed();
+  msg(Info)<<"Finished edge calculation for "<<fullName<<": preprocessing "<<tPreproces<<"ms, crease edges "<<tCrease
+           <<"ms, boundary edges "<<tBoundary<<"ms"<<endl;
 }
 
 void IvBody::addEdgesToScene() {
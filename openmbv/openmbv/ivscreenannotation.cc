@@ -165,7 +165,8 @@ double IvScreenAnnotation::update() {
 
   // read from hdf5
   int frame=MainWindow::getInstance()->getFrame()->getValue();
-  vector<double> data=ivsa->getRow(frame);
+  data.resize(ivsa->getColumnLabels().size()); // allocates only on the first call
+  ivsa->getRow(frame, data.size(), data.data());
   
   auto setColumnLabelFields = [this](const vector<double> &data) {
     for(size_t i=0; i<columnLabelFields.size(); ++i)
@@ -175,7 +176,7 @@ double IvScreenAnnotation::update() {
 
   // path
   for(int i=pathMaxFrameRead+1; i<=frame; i++) {
-    vector<double> data=ivsa->getRow(i);
+    ivsa->getRow(i, data.size(), data.data());
     setColumnLabelFields(data);
     for(size_t idx=0; idx<pathPath.size(); ++idx) {
       gma->setViewportRegion(MainWindow::getInstance()->glViewer->getViewportRegion());
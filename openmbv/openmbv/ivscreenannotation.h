@@ -42,6 +42,7 @@ class IvScreenAnnotation : public Body {
   protected:
     std::shared_ptr<OpenMBV::IvScreenAnnotation> ivsa;
     std::vector<SoAlphaTest*> columnLabelFields;
+    std::vector<double> data; // buffer for the current row, reused on each update
     SoSeparator *sep;
 
     std::vector<SoCoordinate3*> pathCoord;
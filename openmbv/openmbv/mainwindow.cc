@@ -22,6 +22,8 @@
 #include <openmbvcppinterface/group.h>
 #include <openmbvcppinterface/cube.h>
 #include <openmbvcppinterface/compoundrigidbody.h>
+#include <openmbvcppinterface/rowcache.h>
+#include <openmbvcppinterface/xmlcache.h>
 #include "mainwindow.h"
 #include "mytouchwidget.h"
 #include <algorithm>
@@ -52,6 +54,7 @@
 #include <QScreen>
 #include "utils.h"
 #include <QMetaMethod>
+#include <QStandardPaths>
 #include <Inventor/nodes/SoBaseColor.h>
 #include <Inventor/nodes/SoCone.h>
 #include <Inventor/nodes/SoOrthographicCamera.h>
@@ -86,6 +89,7 @@
 #include <hdf5serie/file.h>
 #include <Inventor/SbViewportRegion.h>
 #include <Inventor/actions/SoRayPickAction.h>
+#include <Inventor/actions/SoGetBoundingBoxAction.h>
 #include <Inventor/SoPickedPoint.h>
 #include "IndexedTesselationFace.h"
 #include "utils.h"
@@ -166,6 +170,7 @@ MainWindow::MainWindow(list<string>& arg, bool _skipWindowState) : fpsMax(25), e
   connect(shortAniTimer, &QTimer::timeout, this, &MainWindow::shortAni );
 
   offScreenRenderer=new SoOffscreenRenderer(SbViewportRegion(10, 10));
+  bboxAction=new SoGetBoundingBoxAction(SbViewportRegion(0, 0));
 
   // main widget
   auto *mainWG=new QWidget(this);
@@ -245,6 +250,7 @@ MainWindow::MainWindow(list<string>& arg, bool _skipWindowState) : fpsMax(25), e
   fgColorBottom=new SoMFColor;
   fgColorBottom->set1Value(0, 1,1,1);
   glViewer=new SoQtMyViewer(glViewerWG);
+  cameraSensor=new SoNodeSensor(cameraSensorCB, this); // attached to the camera in setCameraType
 
   auto *offset=new SoPolygonOffset; // move lines/points to front
   sceneRoot->addChild(offset);
@@ -705,6 +711,28 @@ MainWindow::MainWindow(list<string>& arg, bool _skipWindowState) : fpsMax(25), e
   connect(hdf5RefreshTimer, &QTimer::timeout, this, &MainWindow::hdf5RefreshSlot);
   if(hdf5RefreshDelta>0)
     hdf5RefreshTimer->start(hdf5RefreshDelta);
+  interpolateFrames=appSettings->get<int>(AppSettings::interpolateFrames);
+  skipInvisibleBodies=appSettings->get<int>(AppSettings::skipInvisibleBodies);
+
+  // cache of the parsed XML files (must be set before the files are opened)
+  enableXMLCache(appSettings->get<int>(AppSettings::xmlCache));
+  // the same for the on disk cache of the edge calculation
+  setEdgeCalculationDiskCache(appSettings->get<int>(AppSettings::edgeCalculationDiskCache));
+
+  // read-ahead of HDF5 rows in a thread (see frameSensorCB and prefetchSlot)
+  OpenMBV::RowCache::setMemoryBudget(static_cast<size_t>(appSettings->get<int>(AppSettings::rowCacheMemoryBudget))*1024*1024);
+  prefetchTimer=new QTimer(this);
+  prefetchTimer->setSingleShot(true);
+  connect(prefetchTimer, &QTimer::timeout, this, &MainWindow::prefetchSlot);
+
+  // detection of static bodies in a thread (see staticBodySlot and Body::setStatic)
+  staticBodyTimer=new QTimer(this);
+  staticBodyTimer->setSingleShot(true);
+  connect(staticBodyTimer, &QTimer::timeout, this, &MainWindow::staticBodySlot);
+  connect(&staticBodyThread, &QThread::finished, this, &MainWindow::staticBodyFinished);
+
+  // reading of the time index in a thread (see updateTimeIndex)
+  connect(&timeIndexThread, &QThread::finished, this, &MainWindow::timeIndexFinished);
 
   // react on parameters
 
@@ -899,6 +927,7 @@ MainWindow::MainWindow(list<string>& arg, bool _skipWindowState) : fpsMax(25), e
     auto color=appSettings->get<QColor>(AppSettings::outlineShilouetteEdgeLineColor);
     auto rgb=color.rgb();
     olseColor->rgb.set1Value(0, qRed(rgb)/255.0, qGreen(rgb)/255.0, qBlue(rgb)/255.0);
+    EdgeCalculation::setVertexWelding(static_cast<EdgeCalculation::VertexWelding>(appSettings->get<int>(AppSettings::edgeCalculationVertexWelding)));
     int complexityType=appSettings->get<int>(AppSettings::complexityType);
     complexity->type.setValue( complexityType==0 ? SoComplexity::OBJECT_SPACE :
                               (complexityType==1 ? SoComplexity::SCREEN_SPACE :
@@ -1097,6 +1126,9 @@ void MainWindow::highlightObject(const string &curID) {
 }
 
 MainWindow::~MainWindow() {
+  stopPrefetch();
+  stopStaticBodyDetection();
+  stopTimeIndex();
   // unload all top level files before exit (from last to first since the unload removes the element from the list)
   for(int i=objectList->invisibleRootItem()->childCount()-1; i>=0; i--)
     ((Group*)(objectList->invisibleRootItem()->child(i)))->unloadFileSlot();
@@ -1113,6 +1145,7 @@ MainWindow::~MainWindow() {
   highlightColor->unref();
   highlightDrawStyle->unref();
   delete offScreenRenderer;
+  delete bboxAction;
   delete fpsTime;
   delete time;
   delete glViewer;
@@ -1124,6 +1157,7 @@ MainWindow::~MainWindow() {
   delete engDrawingFGColorTopSaved;
   SoDB::renameGlobalField("frame", ""); // delete global field
   delete frameSensor;
+  delete cameraSensor;
   delete mouseCursorSizeField;
   delete relCursorZ;
 
@@ -1138,6 +1172,9 @@ MainWindow::~MainWindow() {
 
 bool MainWindow::openFile(const std::string& fileName, QTreeWidgetItem* parentItem, SoGroup *soParent, int ind) {
   fmatvec::AdoptCurrentMessageStreamsUntilScopeExit dummy(this);
+  stopPrefetch();
+  stopStaticBodyDetection();
+  stopTimeIndex();
 
   // default parameter
   if(parentItem==nullptr) parentItem=objectList->invisibleRootItem();
@@ -1165,7 +1202,19 @@ bool MainWindow::openFile(const std::string& fileName, QTreeWidgetItem* parentIt
     rootGroup->read();
 
     // Duplicate OpenMBVCppInterface tree using OpenMBV tree
+    int animRangeBodiesBefore=animRangeBodies;
     (*rootGroupOMBV)=static_cast<Group*>(ObjectFactory::create(rootGroup, parentItem, soParent, ind));
+    // the frame range is set by the drawn bodies only (see Body::initAnimRange). If no drawn body has data (e.g. all
+    // bodies are disabled) take it from the first body with data (this opens the HDF5 data of the bodies before it)
+    if(animRangeBodies==animRangeBodiesBefore) {
+      Body *first=nullptr;
+      Utils::visitTreeWidgetItems<Body*>(*rootGroupOMBV, [&first](Body *body) {
+        if(!first && std::static_pointer_cast<OpenMBV::Body>(body->object)->getRows()>0)
+          first=body;
+      });
+      if(first)
+        first->initAnimRange();
+    }
     (*rootGroupOMBV)->setText(0, fileName.c_str());
     (*rootGroupOMBV)->setToolTip(0, QFileInfo(fileName.c_str()).absoluteFilePath());
     (*rootGroupOMBV)->getIconFile()="h5file.svg";
@@ -1180,6 +1229,9 @@ bool MainWindow::openFile(const std::string& fileName, QTreeWidgetItem* parentIt
 
   updateBackgroundNeeded();
 
+  // detect the static bodies of all files as soon as the GUI gets idle
+  staticBodyTimer->start(0);
+
   return true;
 }
 
@@ -1480,6 +1532,30 @@ void MainWindow::frameSensorCB(void *data, SoSensor*) {
   me->setObjectInfo(me->objectList->currentItem());
   me->timeSlider->setValue(MainWindow::instance->getFrame()->getValue());
   me->frameSB->setValue(MainWindow::instance->getFrame()->getValue());
+
+  // restart the read-ahead in the direction of the last frame change as soon as the GUI gets idle
+  int newFrame=MainWindow::instance->getFrame()->getValue();
+  if(newFrame!=me->prefetchLastFrame)
+    me->prefetchDirection=newFrame>me->prefetchLastFrame ? 1 : -1;
+  me->prefetchLastFrame=newFrame;
+  me->prefetchTimer->start(0);
+
+  // show the time of the current (interpolated) frame: from the time index or, until the index is read, from the
+  // time column of the body the index is read from
+  int indexed=me->timeIndex.size();
+  double t;
+  if(newFrame<indexed)
+    t=me->timeIndex[newFrame]+(newFrame+1<indexed ? me->frameFraction*(me->timeIndex[newFrame+1]-me->timeIndex[newFrame]) : 0);
+  else if(me->findBodyForLastFrame() && newFrame<me->openMBVBodyForLastFrame->getRows()) {
+    me->updateTimeIndex();
+    double time[2]={0, 0};
+    bool next=me->frameFraction>0 && newFrame+1<me->openMBVBodyForLastFrame->getRows();
+    me->openMBVBodyForLastFrame->getColumns(newFrame, next ? 2 : 1, 0, 1, time);
+    t=time[0]+(next ? me->frameFraction*(time[1]-time[0]) : 0);
+  }
+  else
+    return; // no body has data
+  me->setTime(t);
 }
 
 void MainWindow::fpsCB() {
@@ -1508,6 +1584,7 @@ void MainWindow::restartPlay() {
     // emulate anim stop click
     animTimer->stop();
     // emulate anim play click
+    updateTimeIndex();
     animStartFrame=frame->getValue();
     time->restart();
     if(fpsMax<1e-15)
@@ -1520,24 +1597,43 @@ void MainWindow::restartPlay() {
 void MainWindow::heavyWorkSlot() {
   if(playAct->isChecked()) {
     double dT=time->elapsed()/1000.0*speedSB->value();// time since play click
-    auto dframe=(int)(dT/deltaTime);// frame increment since play click
-    unsigned int frame_=(animStartFrame+dframe-timeSlider->currentMinimum()) %
-                        (timeSlider->currentMaximum()-timeSlider->currentMinimum()+1) + timeSlider->currentMinimum(); // frame number
-    if(frame->getValue()!=frame_) frame->setValue(frame_); // set frame => update scene
+    int minFrame=timeSlider->currentMinimum();
+    int maxFrame=timeSlider->currentMaximum();
+    unsigned int frame_;
+    double fraction=0; // the position between frame_ and the next frame
+    if(timeIndexAvailable(minFrame, maxFrame) && animStartFrame>=minFrame && animStartFrame<=maxFrame) {
+      // the frame at the time since play click; after the last frame the animation restarts one mean time step later
+      double period=timeIndex[maxFrame]-timeIndex[minFrame]+getMeanDeltaTime(minFrame, maxFrame);
+      double t=timeIndex[minFrame]+fmod(timeIndex[animStartFrame]-timeIndex[minFrame]+dT, period);
+      frame_=getFrameForTime(t, minFrame, maxFrame);
+      if(static_cast<int>(frame_)<maxFrame)
+        fraction=(t-timeIndex[frame_])/(timeIndex[frame_+1]-timeIndex[frame_]);
+    }
+    else {
+      double dframe=dT/deltaTime;// frame increment since play click
+      frame_=(animStartFrame+(int)dframe-minFrame) % (maxFrame-minFrame+1) + minFrame; // frame number
+      if(static_cast<int>(frame_)<maxFrame)
+        fraction=dframe-floor(dframe);
+    }
+    if(!interpolateFrames)
+      fraction=0;
+    if(frame->getValue()!=frame_) { // set frame => update scene
+      frameFraction=fraction;
+      animationFrame=frame_>frame->getValue() ? static_cast<int>(frame_) : -1; // a restart at minFrame is a jump
+      frame->setValue(frame_);
+    }
+    else if(frameFraction!=fraction) { // only the position between two frames has changed => update scene
+      frameFraction=fraction;
+      frame->touch();
+    }
     //glViewer->render(); // force rendering
   }
   else if(lastFrameAct->isChecked()) {
     // request a flush of all writers
     requestHDF5Flush();
     // get number of rows of first none enviroment body
-    if(!openMBVBodyForLastFrame) {
-      auto it=Body::getBodyMap().begin();
-      while(it!=Body::getBodyMap().end() && std::static_pointer_cast<OpenMBV::Body>(it->second->object)->getRows()==0)
-        it++;
-      if(it==Body::getBodyMap().end())
-        return;
-      openMBVBodyForLastFrame=std::static_pointer_cast<OpenMBV::Body>(it->second->object);
-    }
+    if(!findBodyForLastFrame())
+      return;
     // use number of rows for found first none enviroment body
     int currentNumOfRows=openMBVBodyForLastFrame->getRows();
     if(deltaTime==0 && currentNumOfRows>=2)
@@ -1548,23 +1644,155 @@ void MainWindow::heavyWorkSlot() {
     if(currentNumOfRows-1!=timeSlider->totalMaximum() || currentNumOfRows-1!=static_cast<int>(frame->getValue())) {
       timeSlider->setTotalMaximum(currentNumOfRows-1);
       timeSlider->setCurrentMaximum(currentNumOfRows-1);
+      animationFrame=currentNumOfRows-1;
       frame->setValue(currentNumOfRows-1);
     }
   }
 }
 
+void MainWindow::prefetchSlot() {
+  stopPrefetch();
+  if(OpenMBV::RowCache::getMemoryBudget()==0)
+    return;
+  // prefetch the rows needed for about one second of animation (play is always forward)
+  int direction=playAct->isChecked() ? 1 : prefetchDirection;
+  double dt=getMeanDeltaTime(timeSlider->currentMinimum(), timeSlider->currentMaximum());
+  double rowsPerSecond=dt>0 ? speedSB->value()/dt : 0;
+  int numRows=static_cast<int>(min(max(rowsPerSecond, 1.0), 1e6));
+  // the thread holds a reference to all bodies to prefetch; the GUI objects must not be accessed by the thread
+  for(auto &[node, body] : Body::getBodyMap())
+    if(body->drawThisPath)
+      prefetchThread.bodies.emplace_back(static_pointer_cast<OpenMBV::Body>(body->object));
+    else
+      prefetchThread.openBodies.emplace_back(static_pointer_cast<OpenMBV::Body>(body->object));
+  prefetchThread.frame=frame->getValue();
+  prefetchThread.numRows=direction*numRows;
+  prefetchThread.cancel=false;
+  prefetchThread.start(QThread::LowPriority);
+}
+
+void MainWindow::enableXMLCache(bool enable) {
+  QString dir=QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  OpenMBV::XMLCache::setDirectory(enable && !dir.isEmpty() ? (dir+"/ombvx").toStdString() : "");
+}
+
+void MainWindow::setEdgeCalculationDiskCache(int size) {
+  EdgeCalculation::setDiskCacheSize(size<=0 ? 0 : (static_cast<size_t>(256)*1024*1024)<<(2*(size-1)));
+}
+
+void MainWindow::stopPrefetch() {
+  prefetchThread.cancel=true;
+  prefetchThread.wait();
+  prefetchThread.bodies.clear(); // release the bodies in the GUI thread
+  prefetchThread.openBodies.clear();
+}
+
+void MainWindow::PrefetchThread::run() {
+  // read one block per body in turn (all bodies are needed for the next frames) until all rows are cached.
+  // The HDF5 reads are serialized by the row cache, hence more than one thread would not speed up reading.
+  try {
+    bool pending=true;
+    while(pending && !cancel) {
+      pending=false;
+      for(auto &body : bodies) {
+        if(cancel)
+          break;
+        if(body->prefetchRows(frame, numRows))
+          pending=true;
+      }
+    }
+    // open the HDF5 data of the bodies not drawn yet, so that enabling them later does not need to open it
+    for(auto &body : openBodies) {
+      if(cancel)
+        break;
+      body->openHDF5FileIfPending();
+    }
+  }
+  catch(...) {
+    // just stop prefetching; the error is reported when the GUI thread reads the row
+  }
+}
+
+void MainWindow::staticBodySlot() {
+  stopStaticBodyDetection();
+  // the thread holds a reference to all bodies to check; the GUI objects must not be accessed by the thread
+  for(auto &[node, body] : Body::getBodyMap()) {
+    auto rigidBody=dynamic_pointer_cast<OpenMBV::RigidBody>(body->object);
+    // rigid bodies inside a compound rigid body are updated by the compound
+    if(rigidBody && body->drawThisPath && !body->isStatic && !rigidBody->getParent().expired())
+      staticBodyThread.bodies.emplace_back(rigidBody);
+  }
+  staticBodyThread.cancel=false;
+  staticBodyThread.start(QThread::LowestPriority);
+}
+
+void MainWindow::stopStaticBodyDetection() {
+  staticBodyTimer->stop();
+  staticBodyThread.cancel=true;
+  staticBodyThread.wait();
+  staticBodyThread.bodies.clear(); // release the bodies in the GUI thread
+  staticBodyThread.constant.clear();
+}
+
+void MainWindow::staticBodyFinished() {
+  // a canceled or restarted detection has no result for the current bodies
+  if(staticBodyThread.isRunning() || staticBodyThread.constant.size()!=staticBodyThread.bodies.size())
+    return;
+  set<OpenMBV::Object*> constant;
+  for(size_t i=0; i<staticBodyThread.bodies.size(); i++)
+    if(staticBodyThread.constant[i])
+      constant.insert(staticBodyThread.bodies[i].get());
+  for(auto &[node, body] : Body::getBodyMap())
+    if(constant.count(body->object.get()))
+      body->setStatic(true);
+  staticBodyThread.bodies.clear();
+  staticBodyThread.constant.clear();
+}
+
+void MainWindow::resetStaticBodies() {
+  stopStaticBodyDetection();
+  for(auto &[node, body] : Body::getBodyMap())
+    body->setStatic(false);
+  // detect again if the files are not refreshed for some time (a running simulation refreshes them continuously)
+  staticBodyTimer->start(2000);
+}
+
+void MainWindow::StaticBodyThread::run() {
+  // compare the columns without the time of all rows with the first row; read the rows in blocks to limit the memory
+  constexpr int blockRows=4096;
+  constexpr int numColumns=7;
+  constant.assign(bodies.size(), false);
+  vector<double> first(numColumns), block;
+  try {
+    for(size_t i=0; i<bodies.size() && !cancel; i++) {
+      int rows=bodies[i]->getRows();
+      if(rows<2)
+        continue; // it is not known yet if the body moves
+      bodies[i]->getColumns(0, 1, 1, numColumns, first.data());
+      bool isConstant=true;
+      for(int r=1; r<rows && isConstant && !cancel; r+=blockRows) {
+        int n=min(blockRows, rows-r);
+        block.resize(n*numColumns);
+        bodies[i]->getColumns(r, n, 1, numColumns, block.data());
+        for(int j=0; j<n*numColumns && isConstant; j++)
+          isConstant=block[j]==first[j%numColumns];
+      }
+      constant[i]=isConstant && !cancel;
+    }
+  }
+  catch(...) {
+    // just stop the detection; the bodies not detected as static are updated as usual
+  }
+  if(cancel)
+    constant.clear();
+}
+
 void MainWindow::hdf5RefreshSlot() {
   // request a flush of all writers
   requestHDF5Flush();
   // get number of rows of first none enviroment body
-  if(!openMBVBodyForLastFrame) {
-    auto it=Body::getBodyMap().begin();
-    while(it!=Body::getBodyMap().end() && std::static_pointer_cast<OpenMBV::Body>(it->second->object)->getRows()==0)
-      it++;
-    if(it==Body::getBodyMap().end())
-      return;
-    openMBVBodyForLastFrame=std::static_pointer_cast<OpenMBV::Body>(it->second->object);
-  }
+  if(!findBodyForLastFrame())
+    return;
   // use number of rows for found first none enviroment body
   int currentNumOfRows=openMBVBodyForLastFrame->getRows();
   if(deltaTime==0 && currentNumOfRows>=2)
@@ -1581,12 +1809,144 @@ void MainWindow::hdf5RefreshSlot() {
 }
 
 void MainWindow::requestHDF5Flush() {
+  std::scoped_lock lock(OpenMBV::RowCache::getHDF5Mutex());
   for(int i=0; i<objectList->topLevelItemCount(); ++i) {
     auto grp=static_cast<Group*>(objectList->topLevelItem(i));
     grp->requestFlush();
   }
 }
 
+bool MainWindow::findBodyForLastFrame() {
+  if(openMBVBodyForLastFrame)
+    return true;
+  auto it=Body::getBodyMap().begin();
+  while(it!=Body::getBodyMap().end() && std::static_pointer_cast<OpenMBV::Body>(it->second->object)->getRows()==0)
+    it++;
+  if(it==Body::getBodyMap().end())
+    return false;
+  openMBVBodyForLastFrame=std::static_pointer_cast<OpenMBV::Body>(it->second->object);
+  return true;
+}
+
+void MainWindow::updateTimeIndex(bool wait) {
+  if(timeIndexThread.isRunning()) {
+    if(!wait)
+      return; // the rows appended in the meantime are read by the next call
+    timeIndexThread.wait();
+    timeIndexFinished();
+  }
+  if(!findBodyForLastFrame()) {
+    timeIndex.clear();
+    return;
+  }
+  int rows=openMBVBodyForLastFrame->getRows();
+  if(rows<static_cast<int>(timeIndex.size())) {
+    // the file was rewritten: build the index again
+    timeIndex.clear();
+    timeIndexIncreasing=true;
+  }
+  int first=timeIndex.size();
+  if(rows==first)
+    return;
+  // read only the time column of the new rows; the thread holds a reference to the body
+  timeIndexThread.body=openMBVBodyForLastFrame;
+  timeIndexThread.firstRow=first;
+  timeIndexThread.numRows=rows-first;
+  timeIndexThread.cancel=false;
+  timeIndexThread.start(QThread::LowPriority);
+  if(wait) {
+    timeIndexThread.wait();
+    timeIndexFinished();
+  }
+}
+
+void MainWindow::stopTimeIndex() {
+  timeIndexThread.cancel=true;
+  timeIndexThread.wait();
+  timeIndexThread.body.reset(); // release the body in the GUI thread
+  timeIndexThread.time.clear();
+}
+
+void MainWindow::timeIndexFinished() {
+  // nothing to do if the thread was restarted or its result is already appended (see updateTimeIndex)
+  if(timeIndexThread.isRunning() || !timeIndexThread.body)
+    return;
+  // a canceled read or a read for an index which was reset meanwhile has no result for the current index
+  if(timeIndexThread.body==openMBVBodyForLastFrame && timeIndexThread.firstRow==static_cast<int>(timeIndex.size()) &&
+     timeIndexThread.time.size()==static_cast<size_t>(timeIndexThread.numRows)) {
+    int first=timeIndex.size();
+    timeIndex.insert(timeIndex.end(), timeIndexThread.time.begin(), timeIndexThread.time.end());
+    for(int i=max(first, 1); i<static_cast<int>(timeIndex.size()) && timeIndexIncreasing; i++)
+      if(!(timeIndex[i]>timeIndex[i-1]))
+        timeIndexIncreasing=false;
+  }
+  timeIndexThread.body.reset(); // release the body in the GUI thread
+  timeIndexThread.time.clear();
+}
+
+void MainWindow::TimeIndexThread::run() {
+  // read the time column in blocks to be able to cancel the read of a long result
+  constexpr int blockRows=65536;
+  time.resize(numRows);
+  try {
+    for(int r=0; r<numRows && !cancel; r+=blockRows)
+      body->getColumns(firstRow+r, min(blockRows, numRows-r), 0, 1, &time[r]);
+  }
+  catch(...) {
+    // no index: the mean delta time is used instead
+    time.clear();
+  }
+  if(cancel)
+    time.clear();
+}
+
+bool MainWindow::timeIndexAvailable(int minFrame, int maxFrame) {
+  // the binary search requires a strictly increasing time
+  return timeIndexIncreasing && 0<=minFrame && minFrame<maxFrame && maxFrame<static_cast<int>(timeIndex.size());
+}
+
+int MainWindow::getFrameForTime(double t, int minFrame, int maxFrame) {
+  // the last frame in [minFrame, maxFrame] not after t (minFrame if t is before minFrame)
+  auto it=upper_bound(timeIndex.begin()+minFrame, timeIndex.begin()+maxFrame+1, t);
+  return max(minFrame, static_cast<int>(it-timeIndex.begin())-1);
+}
+
+double MainWindow::getMeanDeltaTime(int minFrame, int maxFrame) {
+  if(timeIndexAvailable(minFrame, maxFrame))
+    return (timeIndex[maxFrame]-timeIndex[minFrame])/(maxFrame-minFrame);
+  return deltaTime;
+}
+
+void MainWindow::setSkipInvisibleBodies(bool s) {
+  skipInvisibleBodies=s;
+  // the bounding boxes were not refreshed while disabled
+  for(auto &[node, body] : Body::getBodyMap())
+    body->viewBBox.reset();
+  Body::updateSkippedInView();
+}
+
+bool MainWindow::isInView(const SbBox3f &bbox) {
+  // if the camera moves with a body all bodies move relative to the camera on each frame change
+  if(!skipInvisibleBodies || bbox.isEmpty() || cameraPosition->vector.isConnected())
+    return true;
+  float aspect=glViewer->getSceneManager()->getViewportRegion().getViewportAspectRatio();
+  return glViewer->getCamera()->getViewVolume(aspect).intersect(bbox);
+}
+
+void MainWindow::cameraSensorCB(void *data, SoSensor*) {
+  auto *me=static_cast<MainWindow*>(data);
+  if(me->skipInvisibleBodies)
+    Body::updateSkippedInView();
+}
+
+void MainWindow::resetFrameFraction() {
+  // show the stored row of the current frame
+  if(frameFraction!=0) {
+    frameFraction=0;
+    frame->touch();
+  }
+}
+
 void MainWindow::speedWheelChanged(int value) {
   speedSB->setValue(oldSpeed*pow(10,value/10000.0));
 }
@@ -1761,8 +2121,12 @@ void MainWindow::exportSequenceAsPNG(bool video) {
   int startFrame=timeSlider->currentMinimum();
   int endFrame=timeSlider->currentMaximum();
   double fps=dialog.getFPS();
+  resetFrameFraction();
+  updateTimeIndex(true);
+  bool useTimeIndex=timeIndexAvailable(startFrame, endFrame);
+  double dt=getMeanDeltaTime(startFrame, endFrame);
 
-  if(speed/deltaTime/fps<1 && !dialog.skipPNGGeneration()) {
+  if(speed/dt/fps<1 && !dialog.skipPNGGeneration()) {
     int ret=QMessageBox::warning(this, "Export PNG sequence",
       "Some video-frames would contain the same data,\n"
       "because the animation speed is to slow,\n"
@@ -1773,7 +2137,13 @@ void MainWindow::exportSequenceAsPNG(bool video) {
     if(ret==QMessageBox::No) return;
   }
   int videoFrame=0;
-  auto lastVideoFrame=(int)(deltaTime*fps/speed*(endFrame-startFrame));
+  auto lastVideoFrame=(int)(dt*fps/speed*(endFrame-startFrame));
+  // the frame to show in the video frame videoFrame (a frame after endFrame if the video ends)
+  auto frameOfVideoFrame=[&](int videoFrame) {
+    if(useTimeIndex)
+      return videoFrame<=lastVideoFrame ? getFrameForTime(timeIndex[startFrame]+speed/fps*videoFrame, startFrame, endFrame) : endFrame+1;
+    return (int)(speed/deltaTime/fps*videoFrame+startFrame);
+  };
   SbVec2s size=glViewer->getSceneManager()->getViewportRegion().getWindowSize()*scale;
   short width, height; size.getValue(width, height);
   glViewer->fontStyle->size.setValue(glViewer->fontStyle->size.getValue()*scale);
@@ -1783,7 +2153,7 @@ void MainWindow::exportSequenceAsPNG(bool video) {
     removePNGs(pngBaseName);
     progress.setWindowTitle(video ? "Export Video" : "Export PNGs");
     progress.setWindowModality(Qt::WindowModal);
-    for(int frame_=startFrame; frame_<=endFrame; frame_=(int)(speed/deltaTime/fps*++videoFrame+startFrame)) {
+    for(int frame_=startFrame; frame_<=endFrame; frame_=frameOfVideoFrame(++videoFrame)) {
       progress.setValue(videoFrame);
       if(progress.wasCanceled())
         break;
@@ -1880,6 +2250,7 @@ void MainWindow::stopSCSlot() {
   if(hdf5RefreshDelta>0)
     hdf5RefreshTimer->start(hdf5RefreshDelta);
   animTimer->stop();
+  resetFrameFraction();
   stopAct->setChecked(true);
   lastFrameAct->setChecked(false);
   playAct->setChecked(false);
@@ -1895,6 +2266,7 @@ void MainWindow::lastFrameSCSlot() {
 
   stopAct->setChecked(false);
   playAct->setChecked(false);
+  resetFrameFraction();
   if(fpsMax<1e-15)
     animTimer->start();
   else
@@ -1907,11 +2279,13 @@ void MainWindow::playSCSlot() {
   if(!playAct->isChecked()) {
     stopAct->setChecked(true);
     animTimer->stop();
+    resetFrameFraction();
     return;
   }
 
   stopAct->setChecked(false);
   lastFrameAct->setChecked(false);
+  updateTimeIndex();
   animStartFrame=frame->getValue();
   time->restart();
   if(fpsMax<1e-15)
@@ -2282,6 +2656,7 @@ void MainWindow::startShortAni(const std::function<void(double)> &func, bool noA
 
 void MainWindow::setCameraType(SoType type) {
   glViewer->setCameraType(type);
+  cameraSensor->attach(glViewer->getCamera());
   appSettings->set(AppSettings::cameraType, type == SoOrthographicCamera::getClassTypeId() ? 0 : 1);
 
   // 3D cursor scale
@@ -32,8 +32,10 @@
 #include <QtCore/QTimer>
 #include <QtCore/QTime>
 #include <QElapsedTimer>
+#include <QThread>
 #include <string>
 #include <mutex>
+#include <atomic>
 #include "body.h"
 #include "group.h"
 #include "SoSpecial.h"
@@ -62,6 +64,11 @@
 
 class QListWidgetItem;
 class SoCalculator;
+class SoGetBoundingBoxAction;
+
+namespace OpenMBV {
+  class RigidBody;
+}
 
 namespace OpenMBVGUI {
  
@@ -127,12 +134,70 @@ class DLL_PUBLIC MainWindow : public QMainWindow, virtual public fmatvec::Atom {
     SoScale *screenAnnotationScale1To1;
     QTimer *animTimer;
     QTimer *hdf5RefreshTimer;
+    QTimer *prefetchTimer;
+    int prefetchLastFrame { 0 };
+    int prefetchDirection { 1 };
+    // reads ahead the HDF5 rows of all bodies into the row cache and opens the data of the other bodies (see prefetchSlot)
+    class PrefetchThread : public QThread {
+      public:
+        std::vector<std::shared_ptr<OpenMBV::Body>> bodies;
+        std::vector<std::shared_ptr<OpenMBV::Body>> openBodies; // bodies not drawn: only open the HDF5 data
+        int frame { 0 };
+        int numRows { 0 };
+        std::atomic<bool> cancel { false };
+      protected:
+        void run() override;
+    };
+    PrefetchThread prefetchThread;
+    // detects the rigid bodies with constant data, which need no update on frame changes (see Body::setStatic)
+    class StaticBodyThread : public QThread {
+      public:
+        std::vector<std::shared_ptr<OpenMBV::RigidBody>> bodies;
+        std::vector<char> constant; // the result: the data of bodies[i] is constant
+        std::atomic<bool> cancel { false };
+      protected:
+        void run() override;
+    };
+    StaticBodyThread staticBodyThread;
+    // reads the time column of the new rows of openMBVBodyForLastFrame for timeIndex (see updateTimeIndex)
+    class TimeIndexThread : public QThread {
+      public:
+        std::shared_ptr<OpenMBV::Body> body;
+        int firstRow { 0 };
+        int numRows { 0 };
+        std::vector<double> time; // the result: the time of the rows firstRow to firstRow+numRows-1
+        std::atomic<bool> cancel { false };
+      protected:
+        void run() override;
+    };
+    TimeIndexThread timeIndexThread;
+    QTimer *staticBodyTimer;
     QElapsedTimer *time;
     QDoubleSpinBox *speedSB;
     int animStartFrame;
     QActionGroup *animGroup;
     QTripleSlider *timeSlider;
     double deltaTime;
+    int animRangeBodies { 0 }; // the number of bodies which have set the frame range (see Body::resetAnimRange)
+    // the time of each frame read once from the time column of openMBVBodyForLastFrame (new rows are appended).
+    // Used to map a time to a frame by a binary search which is also correct for a non equidistant time.
+    // The index is read in a thread: until it is available the mean delta time is used (see timeIndexAvailable).
+    std::vector<double> timeIndex;
+    bool timeIndexIncreasing { true };
+    bool interpolateFrames { false };
+    bool skipInvisibleBodies { false };
+    SoNodeSensor *cameraSensor; // update the bodies which become visible on camera changes (see Body::skipUpdate)
+    SoGetBoundingBoxAction *bboxAction; // used by all bodies to refresh their bounding box (see Body::updateInView)
+    static void cameraSensorCB(void *data, SoSensor*);
+    int animationFrame { -1 }; // the frame set by the last animation step (see isAnimationStep)
+    double frameFraction { 0 };
+    void resetFrameFraction();
+    bool findBodyForLastFrame();
+    // start reading the time of the new rows in timeIndexThread; if wait is true wait until timeIndex is complete
+    void updateTimeIndex(bool wait=false);
+    bool timeIndexAvailable(int minFrame, int maxFrame);
+    int getFrameForTime(double t, int minFrame, int maxFrame);
+    double getMeanDeltaTime(int minFrame, int maxFrame);
     SoSFUInt32 *frame;
     QLabel *fps;
     QElapsedTimer *fpsTime;
@@ -163,7 +228,7 @@ class DLL_PUBLIC MainWindow : public QMainWindow, virtual public fmatvec::Atom {
     void aboutOpenMBV();
     void guiHelp();
     void xmlHelp();
-    void updateFrame(int frame_) { frame->setValue(frame_); }
+    void updateFrame(int frame_) { frameFraction=0; animationFrame=-1; frame->setValue(frame_); }
     void releaseCameraFromBodySlot();
     void showWorldFrameSlot();
 
@@ -192,6 +257,10 @@ class DLL_PUBLIC MainWindow : public QMainWindow, virtual public fmatvec::Atom {
     void frameSBSetRange(int min, int max) { frameSB->setRange(min, max); } // because QAbstractSlider::setRange is not a slot
     void heavyWorkSlot();
     void hdf5RefreshSlot();
+    void prefetchSlot();
+    void staticBodySlot();
+    void staticBodyFinished();
+    void timeIndexFinished();
     void requestHDF5Flush();
     void restartPlay();
   protected Q_SLOTS:
@@ -295,6 +364,16 @@ class DLL_PUBLIC MainWindow : public QMainWindow, virtual public fmatvec::Atom {
     int getRootItemIndexOfChild(Group *grp) { return objectList->invisibleRootItem()->indexOfChild(grp); }
     void startShortAni(const std::function<void(double)> &func, bool noAni=false);
     void setHDF5RefreshDelta(int d) { hdf5RefreshDelta=d; }
+    void setInterpolateFrames(bool i) { interpolateFrames=i; }
+    // do not update bodies outside of the view on frame changes (see Body::skipUpdate)
+    void setSkipInvisibleBodies(bool s);
+    bool getSkipInvisibleBodies() { return skipInvisibleBodies; }
+    // true if bbox may be visible in the view (always true if bbox is empty or skipping invisible bodies is disabled)
+    bool isInView(const SbBox3f &bbox);
+    // true if the current frame was set by a step of the animation (play or last frame) and not by a jump
+    bool isAnimationStep() { return static_cast<int>(frame->getValue())==animationFrame; }
+    // the weight of the frame after getFrame() if the bodies are interpolated between two frames (0 if not)
+    double getFrameFraction() { return frameFraction; }
 
     enum class StereoType { None, LeftRight };
     void reinit3DView(StereoType stereoType);
@@ -309,6 +388,18 @@ class DLL_PUBLIC MainWindow : public QMainWindow, virtual public fmatvec::Atom {
     QTreeWidget* getObjectList() { return objectList; }
 
     std::set<void*> waitFor;
+    // stop the read-ahead thread; must be called before HDF5 files are opened, refreshed or closed
+    void stopPrefetch();
+    // stop the detection of static bodies; must be called before HDF5 files are opened, refreshed or closed
+    void stopStaticBodyDetection();
+    // stop reading the time index; must be called before HDF5 files are opened, refreshed or closed
+    void stopTimeIndex();
+    // the data may have changed: make all bodies dynamic again and restart the detection of static bodies
+    void resetStaticBodies();
+    // use the binary cache of parsed XML files in the cache directory of the application (see OpenMBV::XMLCache)
+    static void enableXMLCache(bool enable);
+    // set the size of the on disk cache of the edge calculation: 0=off (clears the cache), 1=256MiB, 2=1GiB, 3=4GiB
+    static void setEdgeCalculationDiskCache(int size);
     void setNearPlaneValue(float value);
     float getNearPlaneValue() { return nearPlaneValue; }
     SoSFFloat *relCursorZ;
@@ -34,10 +34,9 @@ namespace OpenMBVGUI {
 NurbsDisk::NurbsDisk(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentItem, SoGroup *soParent, int ind) : DynamicColoredBody(obj, parentItem, soParent, ind) {
   nurbsDisk=std::static_pointer_cast<OpenMBV::NurbsDisk>(obj);
   //h5 dataset
-  int rows=nurbsDisk->getRows();
-  double dt;
-  if(rows>=2) dt=nurbsDisk->getRow(1)[0]-nurbsDisk->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  if(drawThisPath)
+    initAnimRange();
 
   // read XML
   drawDegree=(int)(nurbsDisk->getDrawDegree());
@@ -58,6 +57,7 @@ NurbsDisk::NurbsDisk(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetIte
     knotVecRadial.push_back(dummy[i]);
 
   nurbsLength = (nr+1)*(nj+degAzimuthal);
+  data.resize(7+3*nurbsLength+3*nj*drawDegree*2);
 
   // create so
 
@@ -248,8 +248,11 @@ void NurbsDisk::moveCameraWithSlot() {
 
 double NurbsDisk::update() {
   // read from hdf5
-  int frame = MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data = nurbsDisk->getRow(frame);
+  double fraction=readFrame(data.size(), data.data());
+  // interpolated frame: the rotation spherical linear, all other columns (e.g. the control points) linear
+  blendRow(data.data(), 0, 4, fraction);
+  blendCardan(data.data(), 4, fraction);
+  blendRow(data.data(), 7, data.size()-7, fraction);
 
   // vector of the position of the disk (midpoint of base circle, not midplane!)
   translation->translation.setValue(data[1], data[2], data[3]);
@@ -90,6 +90,9 @@ class NurbsDisk : public DynamicColoredBody {
     /** number of nurbs control points */
     int nurbsLength;
 
+    /** buffer for the current row, reused on each update */
+    std::vector<double> data;
+
     /** NURBS surface */
     SoIndexedNurbsSurface *surface;
 
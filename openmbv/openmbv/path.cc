@@ -35,10 +35,9 @@ Path::Path(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentI
   setIcon(0, Utils::QIconCached(iconFile));
 
   //h5 dataset
-  int rows=path->getRows();
-  double dt;
-  if(rows>=2) dt=path->getRow(1)[0]-path->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  if(drawThisPath)
+    initAnimRange();
   
   // create so
   auto *col=new SoBaseColor;
@@ -65,10 +64,12 @@ void Path::createProperties() {
 double Path::update() {
   // read from hdf5
   int frame=MainWindow::getInstance()->getFrame()->getValue();
-  vector<double> data=path->getRow(frame);
+  double data[4];
+  path->getRow(frame, 4, data);
+  double pathData[4];
   for(int i=maxFrameRead+1; i<=frame; i++) {
-    vector<double> data=path->getRow(i);
-    coord->point.set1Value(i, data[1], data[2], data[3]);
+    path->getRow(i, 4, pathData);
+    coord->point.set1Value(i, pathData[1], pathData[2], pathData[3]);
   }
   maxFrameRead=frame;
   line->numVertices.setValue(1+frame);
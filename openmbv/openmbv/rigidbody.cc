@@ -28,6 +28,7 @@
 #include <Inventor/nodes/SoMatrixTransform.h>
 #include <Inventor/actions/SoGetMatrixAction.h>
 #include <QMenu>
+#include <QTimer>
 #include "utils.h"
 #include "openmbvcppinterface/rigidbody.h"
 #include <cfloat>
@@ -39,10 +40,9 @@ namespace OpenMBVGUI {
 RigidBody::RigidBody(const std::shared_ptr<OpenMBV::Object> &obj, QTreeWidgetItem *parentItem_, SoGroup *soParent, int ind) : DynamicColoredBody(obj, parentItem_, soParent, ind) {
   rigidBody=std::static_pointer_cast<OpenMBV::RigidBody>(obj);
   //h5 dataset
-  int rows=rigidBody->getRows();
-  double dt;
-  if(rows>=2) dt=rigidBody->getRow(1)[0]-rigidBody->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  if(drawThisPath)
+    initAnimRange();
 
   // create so
 
@@ -171,36 +171,80 @@ void RigidBody::moveCameraWithSlot() {
 }
 
 double RigidBody::update() {
-  if(rigidBody->getRows()==0) return 0; // do nothing for environement objects
+  if(rigidBody->getRows()==0) { updateChanged=false; return 0; } // do nothing for environement objects
 
   // read from hdf5
   int frame=MainWindow::getInstance()->getFrame()->getValue();
-  vector<double> data=rigidBody->getRow(frame);
+  double data[8];
+  double fraction=readFrame(8, data);
+  // interpolated frame: the time, translation and color linear, the rotation spherical linear
+  blendRow(data, 0, 4, fraction);
+  blendCardan(data, 4, fraction);
+  blendRow(data, 7, 1, fraction);
   
-  // set scene values
-  translation->translation.setValue(data[1], data[2], data[3]);
-  rotationAlpha->angle.setValue(data[4]);
-  rotationBeta->angle.setValue(data[5]);
-  rotationGamma->angle.setValue(data[6]);
-  rotation->rotation.setValue(Utils::cardan2Rotation(SbVec3f(data[4],data[5],data[6])).inverse()); // set rotation matrix (needed for move camera with body)
+  // set scene values (unchanged values are not set to avoid notifications, e.g. for bodies at rest)
+  bool changed=false;
+  changed|=Utils::setValueIfChanged(translation->translation, SbVec3f(data[1], data[2], data[3]));
+  changed|=Utils::setValueIfChanged(rotationAlpha->angle, data[4]);
+  changed|=Utils::setValueIfChanged(rotationBeta->angle, data[5]);
+  changed|=Utils::setValueIfChanged(rotationGamma->angle, data[6]);
+  changed|=Utils::setValueIfChanged(rotation->rotation, Utils::cardan2Rotation(SbVec3f(data[4],data[5],data[6])).inverse()); // set rotation matrix (needed for move camera with body)
 
   // do not change "mat" if color has not changed to prevent
   // invalidating the render cache of the geometry.
-  if(diffuseColor[0]<0) setColor(data[7]);
+  if(diffuseColor[0]<0) changed|=setColor(data[7]);
 
   // path
   if(rigidBody->getPath()) {
-    for(int i=pathMaxFrameRead+1; i<=frame; i++) {
-      vector<double> data=rigidBody->getRow(i);
-      pathCoord->point.set1Value(i, data[1], data[2], data[3]);
-    }
-    pathMaxFrameRead=frame;
-    pathLine->numVertices.setValue(1+frame);
+    pathFrame=frame;
+    loadPath();
+    changed=true;
   }
 
+  updateChanged=changed;
+
   return data[0];
 }
 
+bool RigidBody::getViewCenter(SbVec3f &center) {
+  if(rigidBody->getRows()==0) return false; // environement objects are not moved
+
+  // the (interpolated) translation of the current frame (the rows are cached, hence this is cheap)
+  double data[8];
+  double fraction=readFrame(8, data);
+  blendRow(data, 1, 3, fraction);
+  center.setValue(data[1], data[2], data[3]);
+  return true;
+}
+
+void RigidBody::loadPath() {
+  // read the translation of at most pathChunkRows rows at once. If more rows are missing, the rest is read later in the
+  // event loop and the path is displayed progressively, this way the GUI is not blocked when jumping to the end of a long result
+  constexpr int pathChunkRows=65536;
+  int first=pathMaxFrameRead+1;
+  int num=min(pathFrame-pathMaxFrameRead, pathChunkRows);
+  if(num>0) {
+    pathBuffer.resize(3*num);
+    rigidBody->getColumns(first, num, 1, 3, pathBuffer.data());
+    pathCoord->point.setNum(first+num);
+    SbVec3f *pathData=pathCoord->point.startEditing();
+    for(int i=0; i<num; i++)
+      pathData[first+i].setValue(pathBuffer[3*i+0], pathBuffer[3*i+1], pathBuffer[3*i+2]);
+    pathCoord->point.finishEditing();
+    pathMaxFrameRead=first+num-1;
+  }
+  pathLine->numVertices.setValue(1+min(pathFrame, pathMaxFrameRead));
+
+  if(pathMaxFrameRead<pathFrame && !pathLoadPending) {
+    pathLoadPending=true;
+    QTimer::singleShot(0, this, [this](){
+      pathLoadPending=false;
+      if(rigidBody->getPath())
+        loadPath();
+    });
+  }
+}
+
 QString RigidBody::getInfo() {
   float x, y, z;
   translation->translation.getValue().getValue(x,y,z);
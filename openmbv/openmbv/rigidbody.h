@@ -44,8 +44,13 @@ class RigidBody : public DynamicColoredBody {
     SoSwitch *soLocalFrameSwitch, *soReferenceFrameSwitch, *soPathSwitch;
     SoCoordinate3 *pathCoord;
     SoLineSet *pathLine;
-    int pathMaxFrameRead;
+    int pathMaxFrameRead; // the path is loaded up to this frame (it is not reduced if the frame decreases)
+    int pathFrame { 0 }; // the path should be shown up to this frame
+    bool pathLoadPending { false };
+    std::vector<double> pathBuffer; // buffer for the translations read by loadPath
+    void loadPath();
     double update() override;
+    bool getViewCenter(SbVec3f &center) override;
     SoRotationXYZ *rotationAlpha, *rotationBeta, *rotationGamma;
     SoRotation *rotation; // accumulated rotationAlpha, rotationBeta and rotationGamma
     SoTranslation *translation;
@@ -96,8 +96,6 @@ SpineExtrusion::SpineExtrusion(const std::shared_ptr<OpenMBV::Object> &obj, QTre
 {
   spineExtrusion=std::static_pointer_cast<OpenMBV::SpineExtrusion>(obj);
 
-  std::vector<double> data;
-
   if( spineExtrusion->getStateOffSet().size() > 0 ) {
     data = std::vector<double>(spineExtrusion->getStateOffSet().size()+1);
 
@@ -106,15 +104,16 @@ SpineExtrusion::SpineExtrusion(const std::shared_ptr<OpenMBV::Object> &obj, QTre
 
     //xml dataset
     numberOfSpinePoints = int((spineExtrusion->getStateOffSet().size())/4);
-  } else {
+  }
+  // the HDF5 data is opened on the first read: do not read it for bodies which are not drawn
+  // (a body which is not drawn is not updated and enabling it creates a new object)
+  else if(drawThisPath) {
     //h5 dataset
     data = spineExtrusion->getRow(0);
     numberOfSpinePoints = int((spineExtrusion->getRow(1).size()-1)/4);
   }
-  int rows=spineExtrusion->getRows();
-  double dt;
-  if(rows>=2) dt=spineExtrusion->getRow(1)[0]-spineExtrusion->getRow(0)[0]; else dt=0;
-  resetAnimRange(rows, dt);
+  if(drawThisPath)
+    initAnimRange();
 
   // read XML
   shared_ptr<vector<shared_ptr<OpenMBV::PolygonPoint> > > contour=spineExtrusion->getContour();
@@ -201,8 +200,7 @@ double SpineExtrusion::update() {
   if(spineExtrusion->getRows()==0) return 0; // do nothing for environement objects
 
   // read from hdf5
-  int frame=MainWindow::getInstance()->getFrame()->getValue();
-  std::vector<double> data=spineExtrusion->getRow(frame);
+  blendRow(data.data(), 0, data.size(), readFrame(data.size(), data.data()));
 
   if( spineExtrusion->getStateOffSet().size() > 0 )
     for( size_t i = 0; i < spineExtrusion->getStateOffSet().size(); ++i )
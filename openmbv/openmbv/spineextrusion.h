@@ -55,6 +55,9 @@ class SpineExtrusion : public DynamicColoredBody {
     /** number of spine points */
     int numberOfSpinePoints;
 
+    /** buffer for the current row, reused on each update */
+    std::vector<double> data;
+
     /** twist axis */
     SbVec3f twistAxis;
   
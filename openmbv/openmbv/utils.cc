@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include "utils.h"
+#include <openmbvcppinterface/rowcache.h>
 #include <Inventor/nodes/SoLineSet.h>
 #include <Inventor/nodes/SoComplexity.h>
 #include <Inventor/nodes/SoPerspectiveCamera.h>
@@ -530,6 +531,12 @@ AppSettings::AppSettings() : qSettings(format, scope, organization, application)
   setting[filterType]={"mainwindow/filter/type", 0};
   setting[filterCaseSensitivity]={"mainwindow/filter/casesensitivity", 0};
   setting[transparency]={"mainwindow/sceneGraph/transparency", 2};
+  setting[rowCacheMemoryBudget]={"mainwindow/hdf5/rowCacheMemoryBudget", 256};
+  setting[edgeCalculationVertexWelding]={"mainwindow/sceneGraph/edgeCalculationVertexWelding", 1};
+  setting[edgeCalculationDiskCache]={"mainwindow/sceneGraph/edgeCalculationDiskCache", 2};
+  setting[xmlCache]={"mainwindow/xmlCache", 1};
+  setting[interpolateFrames]={"mainwindow/interpolateFrames", 0};
+  setting[skipInvisibleBodies]={"mainwindow/skipInvisibleBodies", 0};
 
   for(auto &[str, value]: setting)
     if(qSettings.contains(str))
@@ -1262,6 +1269,38 @@ SettingsDialog::SettingsDialog(QWidget *parent) : QDialog(parent) {
   new IntSetting(misc, AppSettings::hdf5RefreshDelta, Utils::QIconCached("time.svg"), "HDF5 refresh delta:", "ms", [](int value){
     MainWindow::getInstance()->setHDF5RefreshDelta(value);
   });
+  new IntSetting(misc, AppSettings::rowCacheMemoryBudget, Utils::QIconCached("settings.svg"), "HDF5 row cache size (0=off):", "MiB", [](int value){
+    MainWindow::getInstance()->stopPrefetch();
+    OpenMBV::RowCache::setMemoryBudget(static_cast<size_t>(value)*1024*1024);
+  });
+  new ChoiceSetting(misc, AppSettings::edgeCalculationVertexWelding, QIcon(), "Edge calculation data structure:",
+                    {{"Ordered map", "Find equal vertices and edges using a std::map (O(log n) per vertex)."},
+                     {"Hash table" , "Find equal vertices and edges using a hash table (O(1) per vertex, much faster for large models)."}}, [](int value){
+    EdgeCalculation::setVertexWelding(static_cast<EdgeCalculation::VertexWelding>(value));
+  });
+  new ChoiceSetting(misc, AppSettings::edgeCalculationDiskCache, QIcon(), "Edge calculation disk cache:",
+                    {{"Off"     , "Do not store the edge data on disk and remove all stored data."},
+                     {"256 MiB" , "Store the edge data of static geometries on disk, use at most 256 MiB (the least recently used data is removed)."},
+                     {"1 GiB"   , "Store the edge data of static geometries on disk, use at most 1 GiB (the least recently used data is removed)."},
+                     {"4 GiB"   , "Store the edge data of static geometries on disk, use at most 4 GiB (the least recently used data is removed)."}}, [](int value){
+    MainWindow::setEdgeCalculationDiskCache(value);
+  });
+  new ChoiceSetting(misc, AppSettings::xmlCache, QIcon(), "XML file cache:",
+                    {{"Off", "Parse the XML files on each open."},
+                     {"On" , "Store the parsed XML files in a binary cache and use it if the file is unchanged (faster open of large files)."}}, [](int value){
+    MainWindow::enableXMLCache(value);
+  });
+  new ChoiceSetting(misc, AppSettings::interpolateFrames, Utils::QIconCached("speed.svg"), "Play between stored frames:",
+                    {{"Off"        , "Show only the stored rows (the animation may jerk if the data is stored sparsely)."},
+                     {"Interpolate", "Interpolate the bodies between two stored rows (smooth animation at the maximal FPS)."}}, [](int value){
+    MainWindow::getInstance()->setInterpolateFrames(value);
+  });
+  new ChoiceSetting(misc, AppSettings::skipInvisibleBodies, QIcon(), "Update of invisible bodies:",
+                    {{"Always", "Read and update all enabled bodies on each frame change."},
+                     {"Skip"  , "Do not read and update bodies outside of the view (faster playback if only a part of the model is visible; "
+                                "a body moving into the view may be shown some frames late)."}}, [](int value){
+    MainWindow::getInstance()->setSkipInvisibleBodies(value);
+  });
   new IntSetting(misc, AppSettings::shortAniTime, Utils::QIconCached("time.svg"), "Short animation time:", "ms");
   new DoubleSetting(misc, AppSettings::speedChangeFactor, Utils::QIconCached("speed.svg"), "Animation speed factor:", "1/key", {},
                     0, numeric_limits<double>::max(), 0.01);
@@ -145,6 +145,17 @@ class Utils : virtual public fmatvec::Atom {
     /** Convenienc function to convert a rotation matrix to cardan angles */
     static SbVec3f rotation2Cardan(const SbRotation& R);
 
+    /** Set the value of a single value field only if it changes (setValue notifies even if the value is the same).
+     * Returns true if the value has changed. */
+    template<class Field, class Value>
+    static bool setValueIfChanged(Field &field, const Value &value) {
+      typename std::decay<decltype(field.getValue())>::type v(value);
+      if(field.getValue()==v)
+        return false;
+      field.setValue(v);
+      return true;
+    }
+
     template<class T>
     static void visitTreeWidgetItems(QTreeWidgetItem *root, std::function<void (T)> func, bool onlySelected=false);
 
@@ -350,6 +361,12 @@ class AppSettings {
       filterType,
       filterCaseSensitivity,
       transparency,
+      rowCacheMemoryBudget,
+      edgeCalculationVertexWelding,
+      edgeCalculationDiskCache,
+      xmlCache,
+      interpolateFrames,
+      skipInvisibleBodies,
       SIZE,
     };
     AppSettings();
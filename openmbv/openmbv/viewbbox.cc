@@ -0,0 +1,75 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#include "config.h"
+#include "viewbbox.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace OpenMBVGUI {
+
+bool ViewBBox::frameChanged(bool animationStep) {
+  current=false;
+  if(--countdown<=0 || (!animationStep && !hasCenter))
+    refreshPending=true;
+  return refreshPending;
+}
+
+void ViewBBox::refresh(const SbBox3f &bbox, const SbVec3f *center) {
+  countdown=refreshInterval;
+  refreshPending=false;
+  current=true;
+  box=bbox;
+  hasCenter=center && !bbox.isEmpty();
+  if(hasCenter) {
+    // the largest distance of a corner of bbox from the reference point
+    radius=0;
+    const SbVec3f &min=bbox.getMin(), &max=bbox.getMax();
+    for(int i=0; i<8; i++) {
+      SbVec3f corner(i&1 ? max[0] : min[0], i&2 ? max[1] : min[1], i&4 ? max[2] : min[2]);
+      radius=std::max(radius, (corner-*center).length());
+    }
+    lastBox.makeEmpty();
+  }
+  else {
+    // include the last box to cover the motion of the body between the refreshes
+    box.extendBy(lastBox);
+    lastBox=bbox;
+  }
+}
+
+void ViewBBox::move(const SbVec3f &center) {
+  if(!hasCenter)
+    return;
+  SbVec3f r(radius, radius, radius);
+  box.setBounds(center-r, center+r);
+  current=true;
+}
+
+void ViewBBox::reset() {
+  countdown=0;
+  refreshPending=true;
+  current=false;
+  box.makeEmpty();
+  lastBox.makeEmpty();
+  hasCenter=false;
+}
+
+}
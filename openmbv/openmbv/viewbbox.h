@@ -0,0 +1,74 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+#ifndef _OPENMBVGUI_VIEWBBOX_H_
+#define _OPENMBVGUI_VIEWBBOX_H_
+
+#include <Inventor/SbBox3f.h>
+
+namespace OpenMBVGUI {
+
+/** The world bounding box of a body used to skip its update if it is outside of the view (see Body::skipUpdate).
+ * Calculating the bounding box from the scene graph is expensive, hence it is only refreshed each refreshInterval
+ * frame changes and on frame jumps. Between the refreshes the box is estimated:
+ * - If the body has a reference point (e.g. the translation of a rigid body) the box is moved with it:
+ *   it is the box of the sphere around the reference point enclosing the body at the last refresh. This is valid for
+ *   any motion of a rigid body, hence no refresh is needed on frame jumps.
+ * - Else the box covers the body at the last two refreshes (the motion between the refreshes) which is only valid
+ *   for a slow motion during an animation. A frame jump or a camera change (see isCurrent) needs a refresh.
+ */
+class ViewBBox {
+  public:
+    /** The box is refreshed the first time after countdown_ frame changes (use different values for different
+     * bodies to distribute the refreshes over the frames). */
+    ViewBBox(int refreshInterval_, int countdown_=0) : refreshInterval(refreshInterval_), countdown(countdown_) {}
+
+    /** Must be called on each frame change before getBox is used.
+     * animationStep is false if the frame was set by a jump (e.g. the time slider).
+     * Returns true if the box must be refreshed for this frame (see needsRefresh). */
+    bool frameChanged(bool animationStep);
+    /** true if the box must be refreshed (call refresh with the box of the updated body) */
+    bool needsRefresh() const { return refreshPending; }
+    /** Refresh the box using the bounding box bbox of the body for the current frame.
+     * If the body has a reference point its current position is center (nullptr if not). */
+    void refresh(const SbBox3f &bbox, const SbVec3f *center=nullptr);
+    /** Move the box to the reference point center of the current frame (does nothing without a reference point). */
+    void move(const SbVec3f &center);
+    /** true if the box is valid for the current frame (after refresh or move) */
+    bool isCurrent() const { return current; }
+    /** Request a refresh at the next frame change, e.g. if the box was not maintained while skipping was disabled.
+     * The box is empty until then (an empty box is always in the view). */
+    void reset();
+    /** the box (empty if unknown) */
+    const SbBox3f& getBox() const { return box; }
+
+  private:
+    int refreshInterval;
+    int countdown; // the number of frame changes until the next refresh
+    bool refreshPending { false };
+    bool current { false };
+    SbBox3f box;
+    SbBox3f lastBox; // the bounding box at the last refresh (without a reference point)
+    bool hasCenter { false };
+    float radius { 0 }; // the radius of the sphere around the reference point enclosing the body
+};
+
+}
+
+#endif
@@ -66,7 +66,7 @@ DOMElement *Arrow::writeXMLFile(DOMNode *parent) {
 
 void Arrow::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(8);
+  data=createDataHDF5(8);
   vector<string> columns;
   columns.emplace_back("Time");
   columns.emplace_back("toPoint x");
@@ -82,13 +82,7 @@ void Arrow::createHDF5File() {
 void Arrow::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void Arrow::initializeUsingXML(DOMElement *element) {
@@ -76,19 +76,33 @@ namespace OpenMBV {
       void append(const T& row) {
         if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
         if(row.size()!=8) throw std::runtime_error("the dimension does not match");
-        if(!std::isnan(dynamicColor))
-        {
-          std::vector<double> tmprow(8);
-          std::copy(&row[0], &row[8], tmprow.begin());
-          tmprow[7]=dynamicColor;
-          data->append(tmprow);
-        }
-        else
-          data->append(row);
+        writeRowsWithDynamicColor(data, 1, 8, &row[0], 7);
       }
 
-      int getRows() override { return data?data->getRows():0; }
-      std::vector<double> getRow(int i) override { return data?data->getRow(i):std::vector<double>(8); }
+      /** Append numRows rows of n values each stored row major in rows (n must be 8).
+       * All rows are written using a single extension of the HDF5 dataset and a single write which is much
+       * faster than calling append for each row. The dynamic color is applied to all rows as in append. */
+      void appendRows(int numRows, int n, const double *rows) {
+        if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
+        if(n!=8 || numRows<0) throw std::runtime_error("the dimension does not match");
+        writeRowsWithDynamicColor(data, numRows, 8, rows, 7);
+      }
+
+      /** Append numRows rows stored row major in rows (see appendRows(int, int, const double*)) */
+      template<typename T>
+      void appendRows(int numRows, const T& rows) {
+        if(numRows<=0 || rows.size()%numRows!=0) throw std::runtime_error("the dimension does not match");
+        appendRows(numRows, rows.size()/numRows, &rows[0]);
+      }
+
+      int getRows() override { openHDF5FileIfPending(); return data?readRows(data):0; }
+      std::vector<double> getRow(int i) override { openHDF5FileIfPending(); return data?readRow(data, i):std::vector<double>(8); }
+      void getRow(int i, int n, double *row) override { openHDF5FileIfPending(); if(data) readRow(data, i, n, row); else std::fill_n(row, n, 0); }
+      void getColumns(int firstRow, int numRows, int firstColumn, int numColumns, double *values) override {
+        openHDF5FileIfPending();
+        if(data) readColumns(data, firstRow, numRows, firstColumn, numColumns, values);
+        else std::fill_n(values, numRows*numColumns, 0);
+      }
 
       /** Convenience; see setHeadDiameter and setHeadLength */
       void setArrowHead(double diameter, double length) {
@@ -0,0 +1,247 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "config.h"
+#include <openmbvcppinterface/asyncwriter.h>
+#include <openmbvcppinterface/rowcache.h>
+#include <hdf5serie/file.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace OpenMBV {
+
+namespace {
+  // the I/O thread handles flush requests of SWMR readers at least this often, even if no rows are appended
+  constexpr chrono::milliseconds flushInterval(50);
+}
+
+AsyncWriter::AsyncWriter(H5::File *file_, size_t bufferBytes) : file(file_),
+  values(max<size_t>(bufferBytes/sizeof(double), 1024)),
+  // a single row of a rigid body has 8 values: this is the maximal number of entries which may be stored in values
+  entries(values.size()/8) {
+  thread=std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+  stop=true;
+  {
+    scoped_lock lock(waitMutex);
+    consumerWait.notify_one();
+  }
+  thread.join();
+}
+
+void AsyncWriter::push(H5::VectorSerie<double> *data, int numRows, int n, const double *rows, int colorColumn, double color,
+                       H5::VectorSerie<double> *timeData) {
+  rethrowError();
+  if(numRows<=0)
+    return;
+  if(colorColumn>=n)
+    throw runtime_error("the dimension does not match");
+  size_t size=static_cast<size_t>(numRows)*n;
+  size_t capacity=values.size();
+
+  // rows not fitting into the ring buffer are written synchronously
+  if(size>capacity) {
+    drain();
+    vector<double> tmp(rows, rows+size);
+    if(colorColumn>=0)
+      for(int r=0; r<numRows; r++)
+        tmp[r*n+colorColumn]=color;
+    scoped_lock lock(RowCache::getHDF5Mutex());
+    appendHyperslab(data, numRows, n, tmp.data());
+    if(timeData)
+      appendHyperslab(timeData, numRows, n, tmp.data(), 0, 1);
+    return;
+  }
+
+  // the rows are stored contiguous: skip the rest of the ring buffer if the rows do not fit at the end
+  size_t head=valueHead.load(memory_order_relaxed);
+  size_t start=head%capacity+size>capacity ? head+capacity-head%capacity : head;
+  size_t end=start+size;
+  size_t eHead=entryHead.load(memory_order_relaxed);
+  // wait until the I/O thread has written enough rows.
+  // valueTail never passes head, hence if the rows were moved to the start of the ring buffer the first condition
+  // may never become true: but if all entries are written (drained) the whole ring buffer is free.
+  waitProducer([this, end, capacity, eHead]() {
+    size_t eTail=entryTail;
+    return (end-valueTail<=capacity || eTail==eHead) && eHead-eTail<entries.size();
+  });
+
+  double *dst=&values[start%capacity];
+  copy(rows, rows+size, dst);
+  if(colorColumn>=0)
+    for(int r=0; r<numRows; r++)
+      dst[r*n+colorColumn]=color;
+  entries[eHead%entries.size()]={data, timeData, numRows, n, start%capacity, end};
+  valueHead.store(end, memory_order_release);
+  entryHead.store(eHead+1);
+
+  // wake the I/O thread if it sleeps (it takes waitMutex before checking for new entries and sleeping)
+  if(consumerWaiting) {
+    scoped_lock lock(waitMutex);
+    consumerWait.notify_one();
+  }
+}
+
+void AsyncWriter::drain() {
+  size_t eHead=entryHead.load(memory_order_relaxed);
+  waitProducer([this, eHead]() { return entryTail==eHead; });
+  rethrowError();
+}
+
+template<class Pred>
+void AsyncWriter::waitProducer(const Pred &ready) {
+  // producerWaiting and the counters are sequentially consistent: either the I/O thread sees producerWaiting and
+  // notifies under waitMutex or the predicate sees the new counters
+  while(!ready()) {
+    rethrowError();
+    unique_lock lock(waitMutex);
+    producerWaiting=true;
+    producerWait.wait(lock, [this, &ready]() { return ready() || hasError; });
+    producerWaiting=false;
+  }
+}
+
+void AsyncWriter::wakeProducer() {
+  if(producerWaiting) {
+    scoped_lock lock(waitMutex);
+    producerWait.notify_one();
+  }
+}
+
+void AsyncWriter::run() {
+  auto lastFlush=chrono::steady_clock::now();
+  while(true) {
+    size_t tail=entryTail.load(memory_order_relaxed);
+    if(tail==entryHead.load()) {
+      if(stop)
+        break;
+      // nothing to write: handle flush requests and sleep until new rows are pushed
+      if(chrono::steady_clock::now()-lastFlush>=flushInterval) {
+        flush();
+        lastFlush=chrono::steady_clock::now();
+      }
+      unique_lock lock(waitMutex);
+      consumerWaiting=true;
+      consumerWait.wait_for(lock, flushInterval, [this, tail]() { return stop || entryHead.load()!=tail; });
+      consumerWaiting=false;
+      continue;
+    }
+
+    // write all pending entries
+    size_t head=entryHead.load(memory_order_acquire);
+    {
+      scoped_lock lock(RowCache::getHDF5Mutex());
+      for(; tail!=head; tail++) {
+        Entry &e=entries[tail%entries.size()];
+        try {
+          appendHyperslab(e.data, e.numRows, e.n, &values[e.offset]);
+          if(e.timeData)
+            appendHyperslab(e.timeData, e.numRows, e.n, &values[e.offset], 0, 1);
+        }
+        catch(...) {
+          setError();
+        }
+        valueTail=e.end;
+        entryTail=tail+1;
+        wakeProducer();
+      }
+    }
+    flush();
+    lastFlush=chrono::steady_clock::now();
+  }
+}
+
+void AsyncWriter::flush() {
+  try {
+    scoped_lock lock(RowCache::getHDF5Mutex());
+    file->flushIfRequested();
+  }
+  catch(...) {
+    setError();
+  }
+}
+
+void AsyncWriter::setError() {
+  scoped_lock lock(waitMutex);
+  if(!error)
+    error=current_exception();
+  hasError=true;
+  producerWait.notify_one();
+}
+
+void AsyncWriter::rethrowError() {
+  if(!hasError)
+    return;
+  exception_ptr e;
+  {
+    scoped_lock lock(waitMutex);
+    swap(e, error);
+    hasError=false;
+  }
+  rethrow_exception(e);
+}
+
+void AsyncWriter::appendHyperslab(H5::VectorSerie<double> *data, int numRows, int n, const double *rows,
+                                  int firstColumn, int numColumns) {
+  if(numRows<=0)
+    return;
+  if(numColumns<0) {
+    firstColumn=0;
+    numColumns=n;
+  }
+  hid_t dataset=data->getID();
+  hid_t fileSpace=H5Dget_space(dataset);
+  if(fileSpace<0)
+    throw runtime_error("Unable to get the dataspace of a HDF5 dataset.");
+  hsize_t dims[2]={0, 0};
+  H5Sget_simple_extent_dims(fileSpace, dims, nullptr);
+  H5Sclose(fileSpace);
+  if(static_cast<hsize_t>(numColumns)!=dims[1] || firstColumn+numColumns>n)
+    throw runtime_error("the dimension does not match (append: "+to_string(numColumns)+", columns: "+to_string(dims[1])+")");
+
+  // extend the dataset once for all rows and write all rows using a single hyperslab write
+  hsize_t start[2]={dims[0], 0};
+  hsize_t count[2]={static_cast<hsize_t>(numRows), dims[1]};
+  dims[0]+=numRows;
+  herr_t err=H5Dset_extent(dataset, dims);
+  if(err>=0) {
+    fileSpace=H5Dget_space(dataset);
+    err=H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    // select the columns to write in memory
+    hsize_t memDims[2]={static_cast<hsize_t>(numRows), static_cast<hsize_t>(n)};
+    hsize_t memStart[2]={0, static_cast<hsize_t>(firstColumn)};
+    hid_t memSpace=H5Screate_simple(2, memDims, nullptr);
+    if(err>=0 && numColumns!=n)
+      err=H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, nullptr, count, nullptr);
+    if(err>=0)
+      err=H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memSpace, fileSpace, H5P_DEFAULT, rows);
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+  }
+  if(err<0)
+    throw runtime_error("Unable to append "+to_string(numRows)+" rows to a HDF5 dataset.");
+}
+
+}
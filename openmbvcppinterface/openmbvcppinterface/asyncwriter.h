@@ -0,0 +1,99 @@
+/*
+   OpenMBV - Open Multi Body Viewer.
+   Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+   */
+
+#ifndef _OPENMBV_ASYNCWRITER_H_
+#define _OPENMBV_ASYNCWRITER_H_
+
+#include <vector>
+#include <cstddef>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <exception>
+#include <hdf5serie/vectorserie.h>
+
+namespace H5 {
+  class File;
+}
+
+namespace OpenMBV {
+
+  /** Writes the rows appended to the datasets of a H5 file in a background thread (see Group::enableAsyncWrite).
+   * push copies the rows to a bounded ring buffer which is drained by the I/O thread. The ring buffer is lock free
+   * for a single producer thread: push must not be called concurrently from several threads.
+   * If the ring buffer is full push waits until the I/O thread has written enough rows (backpressure).
+   * The I/O thread also handles the flush requests of SWMR readers (H5::File::flushIfRequested) after each batch
+   * of written rows and periodically if no rows are appended.
+   * All HDF5 calls of the I/O thread lock RowCache::getHDF5Mutex().
+   * An error of the I/O thread is rethrown by the next call of push or drain. */
+  class AsyncWriter {
+    public:
+      AsyncWriter(H5::File *file_, size_t bufferBytes);
+      /** Writes all pending rows and stops the I/O thread. Errors are ignored (call drain before to get them). */
+      ~AsyncWriter();
+
+      /** Append numRows rows of n values each (row major) to data.
+       * If colorColumn is not negative, the column colorColumn of each row is overwritten with color.
+       * If timeData is not null, the first column of the rows is also appended to timeData (see Body::setSinglePrecision). */
+      void push(H5::VectorSerie<double> *data, int numRows, int n, const double *rows, int colorColumn=-1, double color=0,
+                H5::VectorSerie<double> *timeData=nullptr);
+
+      /** Wait until all rows pushed so far are written to the H5 file. */
+      void drain();
+
+      /** Append the columns firstColumn to firstColumn+numColumns-1 of numRows rows of n values each (row major) to data
+       * using a single extension of the dataset and a single hyperslab write. numColumns<0 means all n columns.
+       * numColumns must be the number of columns of data. The caller must lock RowCache::getHDF5Mutex(). */
+      static void appendHyperslab(H5::VectorSerie<double> *data, int numRows, int n, const double *rows,
+                                  int firstColumn=0, int numColumns=-1);
+    private:
+      struct Entry {
+        H5::VectorSerie<double> *data;
+        H5::VectorSerie<double> *timeData;
+        int numRows;
+        int n;
+        size_t offset; // the offset of the first value in values
+        size_t end; // the value of valueHead after pushing this entry
+      };
+      H5::File *file;
+      std::vector<double> values; // the ring buffer of the rows
+      std::vector<Entry> entries; // the ring buffer of the pushed blocks of rows
+      // the head counters are only written by the producer, the tail counters only by the I/O thread
+      std::atomic<size_t> valueHead{0}, valueTail{0};
+      std::atomic<size_t> entryHead{0}, entryTail{0};
+      std::atomic<bool> stop{false};
+      std::atomic<bool> producerWaiting{false}, consumerWaiting{false};
+      std::mutex waitMutex; // only used to sleep if the ring buffer is full or empty
+      std::condition_variable producerWait, consumerWait;
+      std::atomic<bool> hasError{false};
+      std::exception_ptr error; // guarded by waitMutex
+      std::thread thread;
+
+      void run();
+      void flush();
+      void setError();
+      void rethrowError();
+      template<class Pred> void waitProducer(const Pred &ready);
+      void wakeProducer();
+  };
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <fstream>
 #include <openmbvcppinterface/group.h>
+#include <openmbvcppinterface/asyncwriter.h>
 
 using namespace std;
 using namespace MBXMLUtils;
@@ -32,6 +33,8 @@ namespace OpenMBV {
 Body::Body() :  outLineStr("true"), shilouetteEdgeStr("false") {
 }
 
+Body::~Body() = default;
+
 DOMElement* Body::writeXMLFile(DOMNode *parent) {
   DOMElement *e=Object::writeXMLFile(parent);
   E(e)->setAttribute("outLine", outLineStr);
@@ -53,8 +56,76 @@ void Body::createHDF5File() {
   hdf5Group=p->hdf5Group->createChildObject<H5::Group>(name)();
 }
 
+H5::VectorSerie<double>* Body::createDataHDF5(int n) {
+  std::shared_ptr<Group> p=parent.lock();
+  int compression=p->getCompression();
+  int chunkRows=p->getChunkRows();
+  if(!getSinglePrecision()) {
+    // use the defaults of hdf5serie if nothing is set
+    if(compression<0 && chunkRows<=0)
+      return hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(n);
+    return hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(n, compression<0 ? Group::defaultCompression : compression,
+                                                                            chunkRows<=0 ? Group::defaultChunkRows : chunkRows);
+  }
+
+  // hdf5serie can only create datasets of the type of the VectorSerie: create a float dataset using HDF5 and open it
+  // as VectorSerie<double>. HDF5 converts between float and double on each read and write.
+  compression=compression<0 ? Group::defaultCompression : compression;
+  chunkRows=chunkRows<=0 ? Group::defaultChunkRows : chunkRows;
+  hsize_t dims[2]={0, static_cast<hsize_t>(n)};
+  hsize_t maxDims[2]={H5S_UNLIMITED, static_cast<hsize_t>(n)};
+  hsize_t chunk[2]={static_cast<hsize_t>(chunkRows), static_cast<hsize_t>(n)};
+  hid_t space=H5Screate_simple(2, dims, maxDims);
+  hid_t prop=H5Pcreate(H5P_DATASET_CREATE);
+  herr_t err=H5Pset_chunk(prop, 2, chunk);
+  if(err>=0 && compression>0)
+    err=H5Pset_deflate(prop, compression);
+  hid_t dataset=err<0 ? -1 : H5Dcreate2(hdf5Group->getID(), "data", H5T_IEEE_F32LE, space, H5P_DEFAULT, prop, H5P_DEFAULT);
+  H5Pclose(prop);
+  H5Sclose(space);
+  if(dataset<0)
+    throw runtime_error("Unable to create the single precision HDF5 dataset 'data' of "+getFullName()+".");
+  H5Dclose(dataset);
+  timeData=hdf5Group->createChildObject<H5::VectorSerie<double> >("time")(1, compression, chunkRows);
+  timeData->setColumnLabel({"Time"});
+  return hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
+}
+
+H5::VectorSerie<double>* Body::openDataHDF5() {
+  timeData=nullptr;
+  {
+    std::scoped_lock lock(rowCacheMutex);
+    timeRowCache.reset();
+  }
+  H5::VectorSerie<double> *data;
+  try {
+    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
+  }
+  catch(...) {
+    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
+    return nullptr;
+  }
+  // single precision data: the time is stored with double precision in "time"
+  if(H5Lexists(hdf5Group->getID(), "time", H5P_DEFAULT)>0)
+    timeData=hdf5Group->openChildObject<H5::VectorSerie<double> >("time");
+  return data;
+}
+
+bool Body::getSinglePrecision() {
+  if(singlePrecision>=0)
+    return singlePrecision;
+  std::shared_ptr<Group> p=parent.lock();
+  return p ? p->getSinglePrecision() : false;
+}
+
 void Body::openHDF5File() {
   hdf5Group=nullptr;
+  {
+    std::scoped_lock lock(rowCacheMutex);
+    rowCache.reset();
+    timeRowCache.reset();
+  }
+  timeData=nullptr;
   try {
     std::shared_ptr<Group> p=parent.lock();
     hdf5Group=p->hdf5Group->openChildObject<H5::Group>(name);
@@ -64,6 +135,98 @@ void Body::openHDF5File() {
   }
 }
 
+void Body::openHDF5FileIfPending() {
+  if(!hdf5OpenPending)
+    return;
+  std::scoped_lock lock(hdf5OpenMutex);
+  if(!hdf5OpenPending)
+    return;
+  {
+    // a prefetch or the deferred open of another body may run in another thread
+    std::scoped_lock hdf5Lock(RowCache::getHDF5Mutex());
+    openHDF5File();
+  }
+  hdf5OpenPending=false;
+}
+
+void Body::readRow(H5::VectorSerie<double> *data, int i, int n, double *row) {
+  readRow(rowCache, data, i, n, row);
+  if(timeData && n>0)
+    readRow(timeRowCache, timeData, i, 1, row);
+}
+
+void Body::readRow(std::shared_ptr<RowCache> &cache, H5::VectorSerie<double> *data, int i, int n, double *row) {
+  if(RowCache::getMemoryBudget()==0) {
+    {
+      std::scoped_lock lock(rowCacheMutex);
+      cache.reset();
+    }
+    std::scoped_lock lock(RowCache::getHDF5Mutex());
+    data->getRow(i, n, row);
+    return;
+  }
+  std::shared_ptr<RowCache> c;
+  {
+    std::scoped_lock lock(rowCacheMutex);
+    if(!cache || cache->getVectorSerie()!=data)
+      cache=std::make_shared<RowCache>(data);
+    c=cache;
+  }
+  c->getRow(i, n, row);
+}
+
+std::vector<double> Body::readRow(H5::VectorSerie<double> *data, int i) {
+  std::scoped_lock lock(RowCache::getHDF5Mutex());
+  std::vector<double> row=data->getRow(i);
+  if(timeData && !row.empty())
+    timeData->getRow(i, 1, row.data());
+  return row;
+}
+
+int Body::readRows(H5::VectorSerie<double> *data) {
+  std::scoped_lock lock(RowCache::getHDF5Mutex());
+  return data->getRows();
+}
+
+void Body::readColumns(H5::VectorSerie<double> *data, int firstRow, int numRows, int firstColumn, int numColumns, double *values) {
+  std::scoped_lock lock(RowCache::getHDF5Mutex());
+  RowCache::readHyperslab(data, firstRow, numRows, firstColumn, numColumns, values);
+  if(timeData && firstColumn==0 && numRows>0 && numColumns>0) {
+    std::vector<double> time(numRows);
+    RowCache::readHyperslab(timeData, firstRow, numRows, 0, 1, time.data());
+    for(int r=0; r<numRows; r++)
+      values[r*numColumns]=time[r];
+  }
+}
+
+void Body::writeRows(H5::VectorSerie<double> *data, int numRows, int n, const double *rows) {
+  if(asyncWriter) {
+    asyncWriter->push(data, numRows, n, rows, -1, 0, timeData);
+    return;
+  }
+  std::scoped_lock lock(RowCache::getHDF5Mutex());
+  AsyncWriter::appendHyperslab(data, numRows, n, rows);
+  if(timeData)
+    AsyncWriter::appendHyperslab(timeData, numRows, n, rows, 0, 1);
+}
+
+bool Body::prefetchRows(int i, int numRows) {
+  openHDF5FileIfPending();
+  // the cache is created on the first read, since only then the dataset to cache is known
+  std::shared_ptr<RowCache> cache, timeCache;
+  {
+    std::scoped_lock lock(rowCacheMutex);
+    cache=rowCache;
+    timeCache=timeRowCache;
+  }
+  if(!cache || RowCache::getMemoryBudget()==0)
+    return false;
+  bool read=cache->prefetch(i, numRows);
+  if(timeCache)
+    read=timeCache->prefetch(i, numRows) || read;
+  return read;
+}
+
 void Body::initializeUsingXML(DOMElement *element) {
   Object::initializeUsingXML(element);
   if(E(element)->hasAttribute("outLine") && 
@@ -23,13 +23,21 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
 #include <openmbvcppinterface/objectfactory.h>
 #include <openmbvcppinterface/object.h>
+#include <openmbvcppinterface/rowcache.h>
 
 namespace OpenMBV {
 
+  class AsyncWriter;
+
   /** Abstract base class for all bodies */
   class Body : public Object {
+    friend class Group;
     public:
       enum DrawStyle { filled, lines, points };
     protected:
@@ -37,11 +45,49 @@ namespace OpenMBV {
       DrawStyle drawMethod{filled};
       double pointSize{0};
       double lineWidth{0};
+      std::shared_ptr<RowCache> rowCache;
+      AsyncWriter *asyncWriter{nullptr}; // set by Group::enableAsyncWrite of the top level group
+      int singlePrecision{-1};
+      H5::VectorSerie<double> *timeData{nullptr}; // the time with double precision if data is stored as float
+      std::shared_ptr<RowCache> timeRowCache;
+      // locks rowCache and timeRowCache: a prefetch in another thread uses its own reference to a cache, hence a cache
+      // is not deleted while it is used even if it is reset or recreated concurrently
+      std::mutex rowCacheMutex;
+      std::atomic<bool> hdf5OpenPending{false}; // set by Group::openHDF5File: openHDF5File is called on the first read
+      std::mutex hdf5OpenMutex; // serializes the deferred openHDF5File
       void createHDF5File() override;
       void openHDF5File() override;
+      /** Create the dataset "data" with n columns in hdf5Group.
+       * The chunk size and compression of the dataset are taken from the parent groups (see Group::setCompression).
+       * If getSinglePrecision() is true, the values are stored as float and the time (first column) is additionally
+       * stored with double precision in the dataset "time". */
+      H5::VectorSerie<double>* createDataHDF5(int n);
+      /** Open the dataset "data" (and "time" if it exists) in hdf5Group. Returns nullptr if "data" does not exist. */
+      H5::VectorSerie<double>* openDataHDF5();
       Body();
-      ~Body() override = default;
+      ~Body() override;
+
+      /** Read row i of data to row using the row cache if the row cache is enabled (see RowCache::setMemoryBudget) */
+      void readRow(H5::VectorSerie<double> *data, int i, int n, double *row);
+      void readRow(std::shared_ptr<RowCache> &cache, H5::VectorSerie<double> *data, int i, int n, double *row);
+      /** Read row i of data (locks RowCache::getHDF5Mutex() since a prefetch may run in another thread) */
+      std::vector<double> readRow(H5::VectorSerie<double> *data, int i);
+      /** Get the number of rows of data (locks RowCache::getHDF5Mutex() since a prefetch may run in another thread) */
+      int readRows(H5::VectorSerie<double> *data);
+      /** Read some columns of some rows of data at once (see RowCache::readHyperslab) */
+      void readColumns(H5::VectorSerie<double> *data, int firstRow, int numRows, int firstColumn, int numColumns, double *values);
+      /** Append numRows rows of n values each (row major) to data using a single extension of the dataset and a single write.
+       * n must be the number of columns of data. All append functions of the bodies use this function.
+       * If asynchronous writing is enabled (see Group::enableAsyncWrite) the rows are only copied to the write queue. */
+      void writeRows(H5::VectorSerie<double> *data, int numRows, int n, const double *rows);
     public:
+      /** Open the HDF5 group and datasets of this body if not done yet.
+       * Group::read does not open the HDF5 data of the bodies, this is done on the first call of getRows, getRow or
+       * prefetchRows, which calls this function. Call this function, e.g. in a background thread, to open the data
+       * before it is needed (see also Group::openPendingHDF5Files). It is safe to call it concurrently to the read
+       * functions of this and other bodies. */
+      void openHDF5FileIfPending();
+
       /** Draw outline of this object in the viewer if true (the default) */
       void setOutLine(bool ol) { outLineStr=(ol)?"true":"false"; }
 
@@ -67,6 +113,15 @@ namespace OpenMBV {
 
       double getLineWidth() { return lineWidth; }
 
+      /** Store the data of this body as float instead of double which halves the file size.
+       * This is useful for bodies with many vertices (e.g. FlexibleBody, DynamicNurbsSurface or NurbsDisk) since the
+       * viewer uses float anyway. The time is still stored with double precision and getRow returns it unchanged.
+       * If not set, the value of the parent group is used (see Group::setSinglePrecision). Call this function before write(). */
+      void setSinglePrecision(bool sp) { singlePrecision=sp; }
+
+      /** Returns true if the data of this body is stored as float */
+      bool getSinglePrecision();
+
       /** Initializes the time invariant part of the object using a XML node */
       void initializeUsingXML(xercesc::DOMElement *element) override;
 
@@ -82,6 +137,28 @@ namespace OpenMBV {
        * NOTE: see also append()
        */
       virtual std::vector<double> getRow(int i)=0;
+
+      /** Get row number i of the default data and store it in the caller supplied buffer row.
+       * row must provide space for n elements, n must be the number of columns of the data.
+       * Unlike getRow(int) this function does not allocate any memory and should be used
+       * if rows are read frequently, e.g. on each frame of the animation.
+       * If no data is available row is filled with 0.
+       */
+      virtual void getRow(int i, int n, double *row)=0;
+
+      /** Read the columns firstColumn to firstColumn+numColumns-1 of the rows firstRow to firstRow+numRows-1 of the
+       * default data to values (row major) using a single read. This is much faster than reading the rows one by one,
+       * e.g. to read the time (column 0) of many rows. If no data is available values is filled with 0.
+       */
+      virtual void getColumns(int firstRow, int numRows, int firstColumn, int numColumns, double *values)=0;
+
+      /** Prefetch the rows from row i to row i+numRows (numRows may be negative) into the row cache.
+       * At most one block of rows (per dataset) is read per call. Returns true if data was read and false if nothing
+       * is left to prefetch or the row cache is not enabled.
+       * This function may be called from a background thread concurrently to getRow(int, int, double*),
+       * but not concurrently to openHDF5File or RowCache::setMemoryBudget.
+       */
+      virtual bool prefetchRows(int i, int numRows);
   };
 
 }
@@ -0,0 +1,59 @@
+#include "config.h"
+#include <openmbvcppinterface/group.h>
+#include <openmbvcppinterface/cube.h>
+#include <chrono>
+#include <iostream>
+
+using namespace OpenMBV;
+using namespace std;
+
+// Measure the write throughput of RigidBody::append (one row per call) and of RigidBody::appendRows (blocks of rows).
+// Usage: appendbench [<number of bodies> [<number of rows per body> [<rows per block>]]]
+
+namespace {
+
+  double run(const string &fileName, int numBodies, int numRows, int blockRows) {
+    shared_ptr<Group> g=ObjectFactory::create<Group>();
+    g->setFileName(fileName);
+    vector<shared_ptr<Cube> > cube(numBodies);
+    for(int b=0; b<numBodies; b++) {
+      cube[b]=ObjectFactory::create<Cube>();
+      cube[b]->setName("cube"+to_string(b));
+      g->addObject(cube[b]);
+    }
+    g->write();
+
+    vector<double> rows(blockRows*8);
+    auto start=chrono::steady_clock::now();
+    for(int i=0; i<numRows; i+=blockRows) {
+      int n=min(blockRows, numRows-i);
+      for(int r=0; r<n; r++)
+        for(int c=0; c<8; c++)
+          rows[r*8+c]=(i+r)*1e-3+c;
+      for(int b=0; b<numBodies; b++)
+        if(blockRows==1)
+          cube[b]->append(rows);
+        else
+          cube[b]->appendRows(n, 8, rows.data());
+    }
+    g=nullptr;
+    cube.clear();
+    return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  int numBodies=argc>1?stoi(argv[1]):100;
+  int numRows=argc>2?stoi(argv[2]):10000;
+  int blockRows=argc>3?stoi(argv[3]):1000;
+
+  double rowTime=run("appendbench_row.ombvx", numBodies, numRows, 1);
+  double blockTime=run("appendbench_block.ombvx", numBodies, numRows, blockRows);
+
+  double total=static_cast<double>(numBodies)*numRows;
+  cout<<numBodies<<" bodies with "<<numRows<<" rows each"<<endl;
+  cout<<"append:     "<<rowTime<<" s, "<<total/rowTime<<" rows/s"<<endl;
+  cout<<"appendRows: "<<blockTime<<" s, "<<total/blockTime<<" rows/s ("<<blockRows<<" rows per block)"<<endl;
+  return 0;
+}
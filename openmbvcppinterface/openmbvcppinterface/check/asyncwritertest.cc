@@ -0,0 +1,107 @@
+#include "config.h"
+#include <openmbvcppinterface/asyncwriter.h>
+#include <openmbvcppinterface/rowcache.h>
+#include <hdf5serie/file.h>
+#include <hdf5serie/vectorserie.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace OpenMBV;
+using namespace std;
+
+// Test the ring buffer of AsyncWriter using a small buffer of 1024 values:
+// blocks wrapping at the end of the ring buffer, backpressure if the ring buffer is full and
+// blocks larger than the ring buffer (written synchronously) in between asynchronous writes.
+// A deadlock is detected by a timeout.
+
+namespace {
+
+  constexpr int n=10; // the number of columns of all datasets
+
+  double value(int dataset, int row, int column) {
+    return dataset*1e6+row*n+column;
+  }
+
+  // push numRows rows starting at row to dataset d
+  void push(AsyncWriter &writer, vector<H5::VectorSerie<double>*> &data, vector<int> &rows, int d, int numRows,
+            int colorColumn=-1) {
+    vector<double> block(numRows*n);
+    for(int r=0; r<numRows; r++)
+      for(int c=0; c<n; c++)
+        block[r*n+c]=value(d, rows[d]+r, c);
+    writer.push(data[d], numRows, n, block.data(), colorColumn, -1);
+    rows[d]+=numRows;
+  }
+
+  bool check(H5::VectorSerie<double> *data, int d, int numRows, int colorColumn) {
+    scoped_lock lock(RowCache::getHDF5Mutex());
+    hid_t space=H5Dget_space(data->getID());
+    hsize_t dims[2]={0, 0};
+    H5Sget_simple_extent_dims(space, dims, nullptr);
+    H5Sclose(space);
+    if(dims[0]!=static_cast<hsize_t>(numRows)) {
+      cerr<<"dataset "<<d<<": "<<dims[0]<<" rows written, expected "<<numRows<<endl;
+      return false;
+    }
+    vector<double> values(numRows*n);
+    RowCache::readHyperslab(data, 0, numRows, 0, n, values.data());
+    for(int r=0; r<numRows; r++)
+      for(int c=0; c<n; c++) {
+        double expected=c==colorColumn ? -1 : value(d, r, c);
+        if(values[r*n+c]!=expected) {
+          cerr<<"dataset "<<d<<", row "<<r<<", column "<<c<<": "<<values[r*n+c]<<", expected "<<expected<<endl;
+          return false;
+        }
+      }
+    return true;
+  }
+
+}
+
+int main() {
+  thread([]() {
+    this_thread::sleep_for(chrono::seconds(120));
+    cerr<<"timeout: AsyncWriter deadlocks"<<endl;
+    _Exit(1);
+  }).detach();
+
+  H5::File file("asyncwritertest.ombvh5", H5::File::write);
+  vector<H5::VectorSerie<double>*> data(3);
+  for(size_t d=0; d<data.size(); d++)
+    data[d]=file.createChildObject<H5::VectorSerie<double> >("data"+to_string(d))(n);
+  file.enableSWMR();
+  vector<int> rows(data.size(), 0);
+
+  {
+    AsyncWriter writer(&file, 1024*sizeof(double));
+
+    // wrap: 100 values and then a block of 1000 values which does not fit at the end of the ring buffer
+    push(writer, data, rows, 0, 10);
+    push(writer, data, rows, 0, 100);
+    writer.drain();
+    // wrap without draining
+    push(writer, data, rows, 0, 60);
+    push(writer, data, rows, 0, 60);
+
+    // backpressure: many blocks of different size, in total many times the size of the ring buffer
+    for(int i=0; i<5000; i++)
+      push(writer, data, rows, 1+i%2, 1+i%97, i%2==0 ? -1 : n-1);
+
+    // blocks larger than the ring buffer in between
+    push(writer, data, rows, 0, 200);
+    push(writer, data, rows, 0, 1);
+    push(writer, data, rows, 0, 500);
+    push(writer, data, rows, 0, 99);
+
+    writer.drain();
+  }
+
+  bool ok=true;
+  ok=check(data[0], 0, rows[0], -1) && ok;
+  ok=check(data[1], 1, rows[1], -1) && ok;
+  ok=check(data[2], 2, rows[2], n-1) && ok;
+  cout<<(ok ? "OK" : "FAILED")<<endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include "config.h"
+#include <openmbvcppinterface/group.h>
+#include <openmbvcppinterface/cube.h>
+#include <openmbvcppinterface/dynamicpointset.h>
+#include <filesystem>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using namespace OpenMBV;
+using namespace std;
+
+// Compare the file size and the sequential and random row read speed of rigid body and flexible body data
+// written with different compression levels and chunk sizes (see Group::setCompression and Group::setChunkRows).
+// Usage: compressionbench [<number of rows> [<number of vertices of the flexible body>]]
+
+namespace {
+
+  double seconds(chrono::steady_clock::time_point start) {
+    return chrono::duration<double>(chrono::steady_clock::now()-start).count();
+  }
+
+  void run(int compression, int chunkRows, int numRows, int numVertices) {
+    string fileName="compressionbench_"+to_string(compression)+"_"+to_string(chunkRows)+".ombvx";
+    {
+      shared_ptr<Group> g=ObjectFactory::create<Group>();
+      g->setFileName(fileName);
+      g->setCompression(compression);
+      g->setChunkRows(chunkRows);
+      shared_ptr<Cube> cube=ObjectFactory::create<Cube>();
+      cube->setName("cube");
+      g->addObject(cube);
+      shared_ptr<DynamicPointSet> flex=ObjectFactory::create<DynamicPointSet>();
+      flex->setName("flex");
+      flex->setNumberOfVertexPositions(numVertices);
+      g->addObject(flex);
+      g->write();
+
+      // smooth time signals as written by a simulation
+      vector<double> row(8), flexRow(1+4*numVertices);
+      for(int i=0; i<numRows; i++) {
+        double t=i*1e-3;
+        row[0]=t;
+        for(int c=1; c<7; c++)
+          row[c]=sin(c*t)+0.1*c;
+        cube->append(row);
+        flexRow[0]=t;
+        for(int v=0; v<numVertices; v++) {
+          for(int c=0; c<3; c++)
+            flexRow[1+4*v+c]=v*0.01+c+1e-3*sin(t*(v%7+1)+c);
+          flexRow[1+4*v+3]=sin(t+v*1e-2);
+        }
+        flex->append(flexRow);
+      }
+    }
+
+    string h5FileName=fileName.substr(0, fileName.length()-6)+".ombvh5";
+    auto size=std::filesystem::file_size(h5FileName);
+
+    shared_ptr<Group> g=ObjectFactory::create<Group>();
+    g->setFileName(fileName);
+    g->read();
+    cout<<"compression="<<compression<<" chunkRows="<<chunkRows<<": "<<size/1024/1024.0<<" MiB"<<endl;
+    mt19937 gen(1);
+    for(auto &o : g->getObjects()) {
+      auto b=static_pointer_cast<Body>(o);
+      int n=b->getRow(0).size();
+      vector<double> row(n);
+
+      auto start=chrono::steady_clock::now();
+      for(int i=0; i<numRows; i++)
+        b->getRow(i, n, row.data());
+      double seq=seconds(start);
+
+      uniform_int_distribution<int> dist(0, numRows-1);
+      int numRandom=min(numRows, 10000);
+      start=chrono::steady_clock::now();
+      for(int i=0; i<numRandom; i++)
+        b->getRow(dist(gen), n, row.data());
+      double rnd=seconds(start);
+
+      cout<<"  "<<b->getName()<<": sequential "<<numRows/seq<<" rows/s, random "<<numRandom/rnd<<" rows/s"<<endl;
+    }
+  }
+
+}
+
+int main(int argc, char *argv[]) {
+  int numRows=argc>1?stoi(argv[1]):20000;
+  int numVertices=argc>2?stoi(argv[2]):1000;
+
+  for(auto [compression, chunkRows] : vector<pair<int, int> >{{0, 100}, {1, 100}, {1, 1000}, {5, 1000}, {9, 1000}})
+    run(compression, chunkRows, numRows, numVertices);
+  return 0;
+}
@@ -21,7 +21,10 @@
 #include <openmbvcppinterface/coilspring.h>
 #include <openmbvcppinterface/compoundrigidbody.h>
 #include <openmbvcppinterface/ivbody.h>
+#include <openmbvcppinterface/xmlcache.h>
 #include <iostream>
+#include <sstream>
+#include <functional>
 
 using namespace OpenMBV;
 using namespace std;
@@ -160,6 +163,35 @@ int main() {
     crb->addRigidBody(ivc);
     g->addObject(crb);
 
+    shared_ptr<Cube> cubeRows=ObjectFactory::create<Cube>();
+    cubeRows->setName("mycuberows");
+    cubeRows->setDynamicColor(0.25);
+    g->addObject(cubeRows);
+
+    // the rigid bodies of this group are stored in a single dataset and append out of order
+    shared_ptr<Group> tableo=ObjectFactory::create<Group>();
+    tableo->setName("myrbtableoutoforder");
+    tableo->setConsolidateRigidBodies(true);
+    g->addObject(tableo);
+      shared_ptr<Cube> cubeO1=ObjectFactory::create<Cube>();
+      cubeO1->setName("mycubeo1");
+      tableo->addObject(cubeO1);
+      shared_ptr<Cube> cubeO2=ObjectFactory::create<Cube>();
+      cubeO2->setName("mycubeo2");
+      tableo->addObject(cubeO2);
+
+    // the rigid bodies of this group are stored in a single dataset
+    shared_ptr<Group> tableg=ObjectFactory::create<Group>();
+    tableg->setName("myrbtable");
+    tableg->setConsolidateRigidBodies(true);
+    g->addObject(tableg);
+      shared_ptr<Cube> cubeT1=ObjectFactory::create<Cube>();
+      cubeT1->setName("mycubet1");
+      tableg->addObject(cubeT1);
+      shared_ptr<Cube> cubeT2=ObjectFactory::create<Cube>();
+      cubeT2->setName("mycubet2");
+      cubeT2->setDynamicColor(0.5);
+      tableg->addObject(cubeT2);
 
   g->write();
 
@@ -182,8 +214,36 @@ int main() {
     invisiblebody->append(row);
     coilspring->append(row);
     crb->append(row);
+    cubeT2->append(row);
+    cubeT1->append(row);
   }
 
+  // append a single row and two blocks of rows (the i-th row has the time i)
+  vector<double> rows(3*8);
+  cubeRows->append(vector<double>(8));
+  for(int i=0; i<3; i++)
+    rows[i*8+0]=1+i;
+  cubeRows->appendRows(3, 8, rows.data());
+  for(int i=0; i<3; i++)
+    rows[i*8+0]=4+i;
+  cubeRows->appendRows(3, rows);
+
+  // out of order append: the incomplete row 0 is written when cubeO1 appends its second row and the times of row 2
+  // differ, a warning is printed once for each case
+  auto warn=make_shared<ostringstream>();
+  fmatvec::Atom::setCurrentMessageStream(fmatvec::Atom::Warn, make_shared<bool>(true), warn);
+  vector<double> rowO(8);
+  rowO[0]=0; rowO[1]=1; cubeO1->append(rowO);
+  rowO[0]=1; rowO[1]=2; cubeO1->append(rowO);
+  rowO[1]=3; cubeO2->append(rowO);
+  rowO[0]=2; rowO[1]=4; cubeO1->append(rowO);
+  rowO[0]=2.5; rowO[1]=5; cubeO2->append(rowO);
+  fmatvec::Atom::setCurrentMessageStream(fmatvec::Atom::Warn, make_shared<bool>(true),
+                                         shared_ptr<ostream>(&cerr, [](ostream*){}));
+  cerr<<warn->str();
+  if(warn->str().find("before all rigid bodies have appended")==string::npos ||
+     warn->str().find("different times")==string::npos) return 1;
+
   }
   cout<<"WALKHIERARCHY"<<endl;
   {
@@ -192,8 +252,59 @@ int main() {
   g->setFileName("mygrp.ombvx");
   g->read();
   walkHierarchy(g);
+
+  shared_ptr<Cube> cubeRows;
+  for(auto &o : g->getObjects())
+    if(o->getName()=="mycuberows")
+      cubeRows=static_pointer_cast<Cube>(o);
+  if(!cubeRows || cubeRows->getRows()!=7) return 1;
+  for(int i=0; i<7; i++) {
+    vector<double> r=cubeRows->getRow(i);
+    if(r[0]!=i || r[7]!=0.25) return 1;
+  }
+
+  auto tableo=static_pointer_cast<Group>(g->getObjects()[g->getObjects().size()-2]);
+  auto cubeO1=static_pointer_cast<Cube>(tableo->getObjects()[0]);
+  auto cubeO2=static_pointer_cast<Cube>(tableo->getObjects()[1]);
+  // all bodies report the number of rows of the table, cubeO2 keeps its initial values in the incomplete row 0
+  if(cubeO1->getRows()!=3 || cubeO2->getRows()!=3) return 1;
+  if(cubeO1->getRow(0)[1]!=1 || cubeO2->getRow(0)[1]!=0 || cubeO2->getRow(1)[1]!=3) return 1;
+  if(cubeO1->getRow(2)[0]!=2 || cubeO2->getRow(2)[1]!=5) return 1;
+
+  auto tableg=static_pointer_cast<Group>(g->getObjects().back());
+  auto cubeT1=static_pointer_cast<Cube>(tableg->getObjects()[0]);
+  auto cubeT2=static_pointer_cast<Cube>(tableg->getObjects()[1]);
+  if(cubeT1->getRows()!=10 || cubeT2->getRows()!=10) return 1;
+  for(int i=0; i<10; i++) {
+    vector<double> r1=cubeT1->getRow(i), r2=cubeT2->getRow(i);
+    if(r1[1]!=i/10.0 || r2[1]!=i/10.0 || r1[7]!=0 || r2[7]!=0.5) return 1;
+  }
   
   }
+  cout<<"XMLCACHE"<<endl;
+  {
+
+  // the first read parses the XML file and writes the cache, the second read uses the cache
+  XMLCache::setDirectory("xmlcache");
+  vector<string> names[2];
+  for(auto &n : names) {
+    shared_ptr<Group> g=ObjectFactory::create<Group>();
+    g->setFileName("mygrp.ombvx");
+    g->read();
+    function<void(const shared_ptr<Group>&)> walk=[&walk, &n](const shared_ptr<Group> &grp) {
+      for(auto &o : grp->getObjects()) {
+        n.emplace_back(o->getFullName());
+        if(auto sg=dynamic_pointer_cast<Group>(o))
+          walk(sg);
+      }
+    };
+    walk(g);
+  }
+  if(!XMLCache::load(MBXMLUtils::DOMParser::create(), "mygrp.ombvx")) return 1;
+  if(names[0].empty() || names[0]!=names[1]) return 1;
+  XMLCache::setDirectory("");
+
+  }
 
 
 
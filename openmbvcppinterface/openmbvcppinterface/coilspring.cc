@@ -53,7 +53,7 @@ DOMElement *CoilSpring::writeXMLFile(DOMNode *parent) {
 
 void CoilSpring::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(8);
+  data=createDataHDF5(8);
   vector<string> columns;
   columns.emplace_back("Time");
   columns.emplace_back("fromPoint x");
@@ -69,13 +69,7 @@ void CoilSpring::createHDF5File() {
 void CoilSpring::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void CoilSpring::initializeUsingXML(DOMElement *element) {
@@ -19,9 +19,11 @@
 
 #include "config.h"
 #include "openmbvcppinterface/dynamiccoloredbody.h"
+#include "openmbvcppinterface/asyncwriter.h"
 #include <fstream>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 
 using namespace std;
 using namespace MBXMLUtils;
@@ -43,6 +45,27 @@ DynamicColoredBody::DynamicColoredBody() :
 
 DynamicColoredBody::~DynamicColoredBody() = default;
 
+void DynamicColoredBody::writeRowsWithDynamicColor(H5::VectorSerie<double> *data, int numRows, int n, const double *rows,
+                                                   int colorColumn) {
+  if(std::isnan(dynamicColor) || numRows<=0) {
+    writeRows(data, numRows, n, rows);
+    return;
+  }
+  if(colorColumn<0 || colorColumn>=n)
+    throw runtime_error("the dimension does not match");
+  // the write queue overwrites the color column when copying the rows
+  if(asyncWriter) {
+    asyncWriter->push(data, numRows, n, rows, colorColumn, dynamicColor, timeData);
+    return;
+  }
+  // resize does not free memory if the buffer shrinks
+  dynamicColorRows.resize(numRows*n);
+  copy(rows, rows+numRows*n, dynamicColorRows.begin());
+  for(int r=0; r<numRows; r++)
+    dynamicColorRows[r*n+colorColumn]=dynamicColor;
+  writeRows(data, numRows, n, dynamicColorRows.data());
+}
+
 DOMElement* DynamicColoredBody::writeXMLFile(DOMNode *parent) {
   DOMElement *e=Body::writeXMLFile(parent);
   E(e)->addElementText(OPENMBV%"minimalColorValue", minimalColorValue);
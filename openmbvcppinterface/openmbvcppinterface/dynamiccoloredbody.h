@@ -33,9 +33,16 @@ namespace OpenMBV {
       double dynamicColor;
       std::vector<double> diffuseColor;
       double transparency{0};
+      std::vector<double> dynamicColorRows; // reused buffer of writeRowsWithDynamicColor
 
       DynamicColoredBody();
       ~DynamicColoredBody() override;
+
+      /** Append numRows rows of n values each (row major) to data (see Body::writeRows).
+       * If the dynamic color is set, column colorColumn of all rows is overwritten with the dynamic color.
+       * The rows are copied to a buffer of this body which is reused for all calls; hence, no memory is
+       * allocated if the number of rows does not grow. */
+      void writeRowsWithDynamicColor(H5::VectorSerie<double> *data, int numRows, int n, const double *rows, int colorColumn);
     public:
       /** Set the minimal color value.
        * The color value of the body in linearly mapped between minimalColorValue
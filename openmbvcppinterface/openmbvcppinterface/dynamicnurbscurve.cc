@@ -39,7 +39,7 @@ DOMElement* DynamicNurbsCurve::writeXMLFile(DOMNode *parent) {
 
 void DynamicNurbsCurve::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(1+5*num);
+  data=createDataHDF5(1+5*num);
   vector<string> columns;
   columns.emplace_back("Time");
   for(int i=0;i<num;i++) {
@@ -55,13 +55,7 @@ void DynamicNurbsCurve::createHDF5File() {
 void DynamicNurbsCurve::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void DynamicNurbsCurve::initializeUsingXML(DOMElement *element) {
@@ -41,7 +41,7 @@ DOMElement* DynamicNurbsSurface::writeXMLFile(DOMNode *parent) {
 
 void DynamicNurbsSurface::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(1+5*numU*numV);
+  data=createDataHDF5(1+5*numU*numV);
   vector<string> columns;
   columns.emplace_back("Time");
   for(int i=0;i<numU*numV;i++) {
@@ -57,13 +57,7 @@ void DynamicNurbsSurface::createHDF5File() {
 void DynamicNurbsSurface::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void DynamicNurbsSurface::initializeUsingXML(DOMElement *element) {
@@ -36,7 +36,7 @@ DOMElement* FlexibleBody::writeXMLFile(DOMNode *parent) {
 
 void FlexibleBody::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(1+4*numvp);
+  data=createDataHDF5(1+4*numvp);
   vector<string> columns;
   columns.emplace_back("Time");
   for(int i=0;i<numvp;i++) {
@@ -51,13 +51,7 @@ void FlexibleBody::createHDF5File() {
 void FlexibleBody::openHDF5File() {
   Body::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void FlexibleBody::initializeUsingXML(DOMElement *element) {
@@ -50,11 +50,32 @@ namespace OpenMBV {
       template<typename T>
       void append(const T& row) { 
         if(data==nullptr) throw std::runtime_error("can not append data to an environment object"); 
-        data->append(row);
+        writeRows(data, 1, row.size(), &row[0]);
       }
 
-      int getRows() override { return data?data->getRows():0; }
-      std::vector<double> getRow(int i) override { return data?data->getRow(i):std::vector<double>(1+3*numvp); }
+      /** Append numRows rows of n values each stored row major in rows (n must be the number of columns of the data).
+       * All rows are written using a single extension of the HDF5 dataset and a single write which is much
+       * faster than calling append for each row. */
+      void appendRows(int numRows, int n, const double *rows) {
+        if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
+        writeRows(data, numRows, n, rows);
+      }
+
+      /** Append numRows rows stored row major in rows (see appendRows(int, int, const double*)) */
+      template<typename T>
+      void appendRows(int numRows, const T& rows) {
+        if(numRows<=0 || rows.size()%numRows!=0) throw std::runtime_error("the dimension does not match");
+        appendRows(numRows, rows.size()/numRows, &rows[0]);
+      }
+
+      int getRows() override { openHDF5FileIfPending(); return data?readRows(data):0; }
+      std::vector<double> getRow(int i) override { openHDF5FileIfPending(); return data?readRow(data, i):std::vector<double>(1+3*numvp); }
+      void getRow(int i, int n, double *row) override { openHDF5FileIfPending(); if(data) readRow(data, i, n, row); else std::fill_n(row, n, 0); }
+      void getColumns(int firstRow, int numRows, int firstColumn, int numColumns, double *values) override {
+        openHDF5FileIfPending();
+        if(data) readColumns(data, firstRow, numRows, firstColumn, numColumns, values);
+        else std::fill_n(values, numRows*numColumns, 0);
+      }
 
       /** Initializes the time invariant part of the object using a XML node */
       void initializeUsingXML(xercesc::DOMElement *element) override;
@@ -21,6 +21,11 @@
 #include <openmbvcppinterface/group.h>
 #include <openmbvcppinterface/body.h>
 #include <openmbvcppinterface/objectfactory.h>
+#include <openmbvcppinterface/asyncwriter.h>
+#include <openmbvcppinterface/rigidbody.h>
+#include <openmbvcppinterface/rigidbodytable.h>
+#include <openmbvcppinterface/xmlcache.h>
+#include <openmbvcppinterface/xmlstreamwriter.h>
 #include <hdf5serie/file.h>
 #include <cassert>
 #include <iostream>
@@ -38,7 +43,17 @@ OPENMBV_OBJECTFACTORY_REGISTERXMLNAME(Group, OPENMBV%"Group")
 Group::Group() : expandStr("true") {
 }
 
-Group::~Group() = default;
+Group::~Group() {
+  try {
+    // the sub groups are destroyed after this group: write their incomplete frames now
+    if(hdf5File)
+      flushRigidBodyTables();
+    disableAsyncWrite();
+  }
+  catch(exception &ex) {
+    msg(Warn)<<"Unable to write all data of "<<fileName<<": "<<ex.what()<<endl;
+  }
+}
 
 void Group::addObject(const shared_ptr<Object>& newObject) {
   if(newObject->name.empty()) throw runtime_error("object to add must have a name");
@@ -71,6 +86,7 @@ DOMElement *Group::writeXMLFile(DOMNode *parent) {
 void Group::createHDF5File() {
   std::shared_ptr<Group> p=parent.lock();
   hdf5Group=p->hdf5Group->createChildObject<H5::Group>(name)();
+  createRigidBodyTable();
   for(auto & i : object)
     if(!i->getEnvironment()) i->createHDF5File();
 }
@@ -89,20 +105,53 @@ void Group::openHDF5File() {
       msg(Debug)<<"Unable to open the HDF5 Group '"<<name<<"'. Using 0 for all data."<<endl;
     }
   }
-  if(hdf5Group)
-    for(auto & i : object)
+  if(hdf5Group) {
+    openRigidBodyTable();
+    openChildHDF5Files();
+  }
+}
+
+void Group::openChildHDF5Files() {
+  for(auto & i : object) {
+    // opening the datasets of all bodies takes long for large files: defer it to the first read of each body
+    if(auto b=dynamic_pointer_cast<Body>(i))
+      b->hdf5OpenPending=true;
+    else
       i->openHDF5File();
+  }
+}
+
+void Group::openPendingHDF5Files(const std::atomic<bool> *cancel) {
+  for(auto & i : object) {
+    if(cancel && *cancel)
+      return;
+    if(auto g=dynamic_pointer_cast<Group>(i))
+      g->openPendingHDF5Files(cancel);
+    else if(auto b=dynamic_pointer_cast<Body>(i))
+      b->openHDF5FileIfPending();
+  }
 }
 
 void Group::writeXML() {
-  // write .ombvx file
-  shared_ptr<DOMParser> parser=DOMParser::create();
-  shared_ptr<DOMDocument> xmlFile=parser->createDocument();
-  DOMElement *parent=Object::writeXMLFile(xmlFile.get());
-  E(parent)->setAttribute("expand", expandStr);
-  for(auto & i : object)
-    i->writeXMLFile(parent);
-  DOMParser::serialize(xmlFile.get(), fileName);
+  // write .ombvx file object by object: only the DOM tree of a single object is in memory
+  XMLStreamWriter writer(fileName);
+  writeXMLStream(writer);
+  writer.close();
+}
+
+void Group::writeXMLStream(XMLStreamWriter &writer) {
+  DOMElement *e=Object::writeXMLFile(writer.getParent());
+  E(e)->setAttribute("expand", expandStr);
+  writer.startElement();
+  for(auto & i : object) {
+    if(auto g=dynamic_pointer_cast<Group>(i))
+      g->writeXMLStream(writer);
+    else {
+      i->writeXMLFile(writer.getParent());
+      writer.write();
+    }
+  }
+  writer.endElement();
 }
 
 void Group::initializeUsingXML(DOMElement *element) {
@@ -129,9 +178,14 @@ void Group::initializeUsingXML(DOMElement *element) {
 }
 
 void Group::readXML() {
-  // read XML
+  // read XML (from the cache if the file is unchanged, see XMLCache)
   shared_ptr<DOMParser> parser=DOMParser::create();
-  shared_ptr<DOMDocument> doc=parser->parse(fileName);  
+  shared_ptr<DOMDocument> doc=XMLCache::load(parser, fileName);
+  if(!doc) {
+    vector<boost::filesystem::path> dependencies;
+    doc=parser->parse(fileName, &dependencies);
+    XMLCache::save(doc.get(), fileName, dependencies);
+  }
 
   if(E(doc->getDocumentElement())->getTagName()!=OPENMBV%"Group")
     throw runtime_error("The root element must be of type {"+OPENMBV.getNamespaceURI()+"}Group");
@@ -157,6 +211,7 @@ void Group::write(bool writeXMLFile, bool writeH5File) {
   // now walk all objects and createw the corresponding groups/datasets in the H5 file
   if(writeH5File) {
     hdf5Group=hdf5File.get();
+    createRigidBodyTable();
     for(auto & i : object)
       i->createHDF5File();
   }
@@ -165,13 +220,129 @@ void Group::write(bool writeXMLFile, bool writeH5File) {
 }
 
 void Group::enableSWMR() {
+  drain();
+  scoped_lock lock(RowCache::getHDF5Mutex());
   hdf5File->enableSWMR(); // this will unblock the h5 file
 }
 
 void Group::flushIfRequested() {
+  // with asynchronous writing the I/O thread handles the flush requests
+  if(asyncWriter)
+    return;
   hdf5File->flushIfRequested();
 }
 
+int Group::getCompression() {
+  if(compression>=0)
+    return compression;
+  std::shared_ptr<Group> p=parent.lock();
+  return p ? p->getCompression() : -1;
+}
+
+int Group::getChunkRows() {
+  if(chunkRows>0)
+    return chunkRows;
+  std::shared_ptr<Group> p=parent.lock();
+  return p ? p->getChunkRows() : 0;
+}
+
+bool Group::getSinglePrecision() {
+  if(singlePrecision>=0)
+    return singlePrecision;
+  std::shared_ptr<Group> p=parent.lock();
+  return p ? p->getSinglePrecision() : false;
+}
+
+bool Group::getConsolidateRigidBodies() {
+  if(consolidateRigidBodies>=0)
+    return consolidateRigidBodies;
+  std::shared_ptr<Group> p=parent.lock();
+  return p ? p->getConsolidateRigidBodies() : false;
+}
+
+void Group::createRigidBodyTable() {
+  rigidBodyTable.reset();
+  vector<shared_ptr<RigidBody> > rbs;
+  vector<string> names;
+  for(auto &o : object)
+    if(auto rb=dynamic_pointer_cast<RigidBody>(o)) {
+      rb->table.reset();
+      if(!rb->getEnvironment()) {
+        rbs.emplace_back(rb);
+        names.emplace_back(rb->getName());
+      }
+    }
+  if(!getConsolidateRigidBodies() || rbs.empty())
+    return;
+  rigidBodyTable=make_shared<RigidBodyTable>(hdf5Group, names, getCompression(), getChunkRows());
+  for(size_t i=0; i<rbs.size(); i++) {
+    rbs[i]->table=rigidBodyTable;
+    rbs[i]->tableIndex=i;
+  }
+}
+
+void Group::openRigidBodyTable() {
+  rigidBodyTable.reset();
+  vector<shared_ptr<RigidBody> > rbs;
+  for(auto &o : object)
+    if(auto rb=dynamic_pointer_cast<RigidBody>(o)) {
+      rb->table.reset();
+      if(!rb->getEnvironment())
+        rbs.emplace_back(rb);
+    }
+  if(rbs.empty() || !RigidBodyTable::exists(hdf5Group))
+    return;
+  rigidBodyTable=make_shared<RigidBodyTable>(hdf5Group, rbs.size());
+  for(size_t i=0; i<rbs.size(); i++) {
+    rbs[i]->table=rigidBodyTable;
+    rbs[i]->tableIndex=i;
+  }
+}
+
+void Group::flushRigidBodyTables() {
+  if(rigidBodyTable)
+    rigidBodyTable->flush();
+  for(auto &o : object)
+    if(auto g=dynamic_pointer_cast<Group>(o))
+      g->flushRigidBodyTables();
+}
+
+void Group::enableAsyncWrite(size_t bufferSize) {
+  if(!parent.expired())
+    throw runtime_error("enableAsyncWrite must be called for the top level group");
+  if(!hdf5File)
+    throw runtime_error("enableAsyncWrite must be called after write");
+  if(asyncWriter)
+    return;
+  asyncWriter=make_unique<AsyncWriter>(hdf5File.get(), bufferSize);
+  setAsyncWriter(asyncWriter.get());
+}
+
+void Group::drain() {
+  if(asyncWriter)
+    asyncWriter->drain();
+}
+
+void Group::disableAsyncWrite() {
+  if(!asyncWriter)
+    return;
+  setAsyncWriter(nullptr);
+  // destroy the writer even if drain throws, its destructor writes all pending rows
+  unique_ptr<AsyncWriter> writer(std::move(asyncWriter));
+  writer->drain();
+}
+
+void Group::setAsyncWriter(AsyncWriter *writer) {
+  if(rigidBodyTable)
+    rigidBodyTable->setAsyncWriter(writer);
+  for(auto &o : object) {
+    if(auto g=dynamic_pointer_cast<Group>(o))
+      g->setAsyncWriter(writer);
+    else if(auto b=dynamic_pointer_cast<Body>(o))
+      b->asyncWriter=writer;
+  }
+}
+
 void Group::refresh() {
   hdf5File->refresh();
 }
@@ -218,9 +389,10 @@ void Group::read() {
         msg(Debug)<<"Unable to open the HDF5 Group '"<<name<<"'. Using 0 for all data."<<endl;
       }
     }
-    if(hdf5Group)
-      for(auto & i : object)
-        i->openHDF5File();
+    if(hdf5Group) {
+      openRigidBodyTable();
+      openChildHDF5Files();
+    }
   }
 }
 
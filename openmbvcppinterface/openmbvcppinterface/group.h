@@ -24,9 +24,15 @@
 #include <openmbvcppinterface/object.h>
 #include <vector>
 #include <map>
+#include <memory>
+#include <atomic>
 
 namespace OpenMBV {
 
+  class AsyncWriter;
+  class RigidBodyTable;
+  class XMLStreamWriter;
+
   /** A container for bodies */
   class Group : public Object
 #ifndef SWIG
@@ -43,6 +49,12 @@ namespace OpenMBV {
       std::shared_ptr<H5::File> hdf5File;
       std::function<void()> closeRequestCallback;
       std::function<void()> refreshCallback;
+      std::unique_ptr<AsyncWriter> asyncWriter;
+      int compression{-1};
+      int chunkRows{0};
+      int singlePrecision{-1};
+      int consolidateRigidBodies{-1};
+      std::shared_ptr<RigidBodyTable> rigidBodyTable;
       void createHDF5File() override;
       void openHDF5File() override;
 
@@ -54,11 +66,28 @@ namespace OpenMBV {
        */
       void writeXML();
 
+      /** Write this group and all its children to writer (see XMLStreamWriter) */
+      void writeXMLStream(XMLStreamWriter &writer);
+
       /** Read the XML file.
        * Call this function to read an OpenMBV XML file and creating the Object tree.
        */
       void readXML();
 
+      /** Set the async writer of all bodies of this tree */
+      void setAsyncWriter(AsyncWriter *writer);
+
+      /** Create (if consolidated) or open (if existing) the dataset "rigidbodies" of this group and assign it to the
+       * rigid bodies. Must be called before the rigid bodies create or open their HDF5 data. */
+      void createRigidBodyTable();
+      void openRigidBodyTable();
+
+      /** Open the HDF5 groups of the sub groups and mark the bodies to open their HDF5 data on the first read */
+      void openChildHDF5Files();
+
+      /** Write the incomplete frames of the rigid body tables of this tree */
+      void flushRigidBodyTables();
+
     public:
       /** Expand this tree node in a view if true (the default) */
       void setExpand(bool expand) { expandStr=(expand)?"true":"false"; }
@@ -91,6 +120,12 @@ namespace OpenMBV {
       /** Read the tree (XML and h5). */
       void read();
 
+      /** Open the HDF5 data of all bodies of this tree not read yet (see Body::openHDF5FileIfPending).
+       * read() only opens the HDF5 groups of the groups, the data of a body is opened on its first read.
+       * This function can be called in a background thread after read() to open the data before it is needed.
+       * It returns early if cancel is set to true (by another thread). */
+      void openPendingHDF5Files(const std::atomic<bool> *cancel=nullptr);
+
       /** Enable SWMR if a H5 file is written. */
       void enableSWMR();
 
@@ -110,6 +145,61 @@ namespace OpenMBV {
        * and this reader should now refresh the file. */
       void setRefreshCallback(const std::function<void()> &refreshCallback_) { refreshCallback=refreshCallback_; }
 
+      /** The compression level and chunk size (in rows) hdf5serie uses if nothing is set */
+      static constexpr int defaultCompression=1;
+      static constexpr int defaultChunkRows=100;
+
+      /** Set the deflate compression level (0 = no compression, 1 to 9) of the datasets of all bodies of this group and
+       * its sub groups. A value less than 0 (the default) uses the value of the parent group.
+       * Call this function before write(). The filter is applied by HDF5 and hence transparent for all readers. */
+      void setCompression(int level) { compression=level; }
+
+      /** Returns the compression level of this group or, if not set, of the parent groups (-1 if not set at all) */
+      int getCompression();
+
+      /** Set the chunk size in rows of the datasets of all bodies of this group and its sub groups.
+       * Larger chunks compress better and are faster for sequential reads, smaller chunks are faster for random reads.
+       * A value less than 1 (the default) uses the value of the parent group. Call this function before write(). */
+      void setChunkRows(int rows) { chunkRows=rows; }
+
+      /** Returns the chunk size of this group or, if not set, of the parent groups (0 if not set at all) */
+      int getChunkRows();
+
+      /** Store the data of all bodies of this group and its sub groups as float (see Body::setSinglePrecision).
+       * If not set, the value of the parent group is used (default false). Call this function before write(). */
+      void setSinglePrecision(bool sp) { singlePrecision=sp; }
+
+      /** Returns true if the data of the bodies of this group is stored as float */
+      bool getSinglePrecision();
+
+      /** Store the data of all rigid bodies (not of sub groups) of this group in a single dataset "rigidbodies" of
+       * this group instead of one dataset per body. Each row of this dataset holds the time and the 7 columns of each
+       * rigid body (see RigidBodyTable). This reduces the number of HDF5 datasets and the number of reads per frame of
+       * a model with many rigid bodies. All rigid bodies of the group must append one row per frame (each in any
+       * order). The rows of the last frame are written if all bodies have appended or when the tree is destroyed.
+       * The dataset is always stored with double precision. Readers detect the dataset automatically.
+       * If not set, the value of the parent group is used (default false). Call this function before write(). */
+      void setConsolidateRigidBodies(bool c) { consolidateRigidBodies=c; }
+
+      /** Returns true if the rigid bodies of this group are stored in a single dataset */
+      bool getConsolidateRigidBodies();
+
+      /** Write the rows appended to all bodies of this tree using a background I/O thread.
+       * append and appendRows of the bodies then only copy the rows to a queue of bufferSize bytes and return
+       * immediately (if the queue is full they wait until the I/O thread has written enough rows).
+       * The I/O thread also handles the flush requests of SWMR readers: flushIfRequested need not be called anymore.
+       * Call this function for the root node of the tree after write() (and usually after enableSWMR()).
+       * The bodies must not be appended from several threads concurrently.
+       * An error writing the rows is thrown by a later append or by drain. */
+      void enableAsyncWrite(size_t bufferSize=64*1024*1024);
+
+      /** Wait until all rows appended so far are written to the H5 file (if asynchronous writing is enabled). */
+      void drain();
+
+      /** Write all pending rows and stop the I/O thread of enableAsyncWrite. Appends are written synchronously again.
+       * This is done automatically when the Group is destroyed. */
+      void disableAsyncWrite();
+
       /** Initializes the time invariant part of the object using a XML node */
       void initializeUsingXML(xercesc::DOMElement *element) override;
 
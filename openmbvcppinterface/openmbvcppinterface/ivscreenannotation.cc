@@ -110,7 +110,7 @@ void IvScreenAnnotation::createHDF5File() {
   std::shared_ptr<Group> p=parent.lock();
   hdf5Group=p->getHDF5Group()->createChildObject<H5::Group>(name)();
 
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(columnLabels.size());
+  data=createDataHDF5(columnLabels.size());
   data->setColumnLabel(columnLabels);
 }
 
@@ -125,13 +125,7 @@ void IvScreenAnnotation::openHDF5File() {
   }
 
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 }
@@ -90,11 +90,24 @@ namespace OpenMBV {
         if(data==nullptr) throw std::runtime_error("IvScreenAnnotation: Cannot append data to an environment object");
         if(row.size()!=static_cast<int>(columnLabels.size())) throw std::runtime_error("IvScreenAnnotation: The dimension does not match (append: "+
                                             std::to_string(row.size())+", columns: "+std::to_string(columnLabels.size())+")");
-        data->append(&row(0), row.size());
+        writeRows(data, 1, row.size(), &row(0));
       }
 
-      int getRows() override { return data?data->getRows():0; }
-      std::vector<double> getRow(int i) override { return data ? data->getRow(i) : std::vector<double>(columnLabels.size()); }
+      /** Append numRows rows of n values each stored row major in rows (n must be the number of column labels).
+       * All rows are written using a single extension of the HDF5 dataset and a single write. */
+      void appendRows(int numRows, int n, const double *rows) {
+        if(data==nullptr) throw std::runtime_error("IvScreenAnnotation: Cannot append data to an environment object");
+        writeRows(data, numRows, n, rows);
+      }
+
+      int getRows() override { openHDF5FileIfPending(); return data?readRows(data):0; }
+      std::vector<double> getRow(int i) override { openHDF5FileIfPending(); return data ? readRow(data, i) : std::vector<double>(columnLabels.size()); }
+      void getRow(int i, int n, double *row) override { openHDF5FileIfPending(); if(data) readRow(data, i, n, row); else std::fill_n(row, n, 0); }
+      void getColumns(int firstRow, int numRows, int firstColumn, int numColumns, double *values) override {
+        openHDF5FileIfPending();
+        if(data) readColumns(data, firstRow, numRows, firstColumn, numColumns, values);
+        else std::fill_n(values, numRows*numColumns, 0);
+      }
     protected:
       IvScreenAnnotation();
       ~IvScreenAnnotation() override = default;
@@ -67,7 +67,7 @@ void NurbsDisk::createHDF5File() {
   DynamicColoredBody::createHDF5File();
   int NodeDofs;
   NodeDofs = (getElementNumberRadial() + 1) * (getElementNumberAzimuthal() + getInterpolationDegreeAzimuthal());
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(7+3*NodeDofs+3*getElementNumberAzimuthal()*drawDegree*2);
+  data=createDataHDF5(7+3*NodeDofs+3*getElementNumberAzimuthal()*drawDegree*2);
   vector<string> columns;
   columns.emplace_back("Time");
 
@@ -99,13 +99,7 @@ void NurbsDisk::createHDF5File() {
 void NurbsDisk::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void NurbsDisk::initializeUsingXML(DOMElement *element) {
@@ -43,7 +43,7 @@ DOMElement* Path::writeXMLFile(DOMNode *parent) {
 
 void Path::createHDF5File() {
   Body::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(4);
+  data=createDataHDF5(4);
   vector<string> columns;
   columns.emplace_back("Time");
   columns.emplace_back("x");
@@ -55,13 +55,7 @@ void Path::createHDF5File() {
 void Path::openHDF5File() {
   Body::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void Path::initializeUsingXML(DOMElement *element) {
@@ -51,8 +51,10 @@ DOMElement* RigidBody::writeXMLFile(DOMNode *parent) {
 }
 
 void RigidBody::createHDF5File() {
+  // the data is stored in the table of the parent group
+  if(table) return;
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(8);
+  data=createDataHDF5(8);
   vector<string> columns;
   columns.emplace_back("Time");
   columns.emplace_back("x");
@@ -66,15 +68,12 @@ void RigidBody::createHDF5File() {
 }
 
 void RigidBody::openHDF5File() {
+  data=nullptr;
+  // the data is read from the table of the parent group
+  if(table) return;
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void RigidBody::initializeUsingXML(DOMElement *element) {
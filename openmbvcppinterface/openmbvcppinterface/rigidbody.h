@@ -21,6 +21,7 @@
 #define _OPENMBV_RIGIDBODY_H_
 
 #include <openmbvcppinterface/dynamiccoloredbody.h>
+#include <openmbvcppinterface/rigidbodytable.h>
 #include <vector>
 #include <cassert>
 #include <hdf5serie/vectorserie.h>
@@ -64,9 +65,13 @@ namespace OpenMBV {
    * A row consists of the following columns in order: time,
    * \f$ _W x_P \f$, \f$ _W y_P \f$, \f$ _W z_P \f$,
    * \f$ \alpha_P \f$, \f$ \beta_P \f$, \f$ \gamma_P \f$,
-   * color */
+   * color
+   *
+   * If the parent Group consolidates its rigid bodies (see Group::setConsolidateRigidBodies) these columns are
+   * stored in the dataset "rigidbodies" of the Group instead. */
   class RigidBody : public DynamicColoredBody {
     friend class CompoundRigidBody;
+    friend class Group;
     protected:
       std::string localFrameStr, referenceFrameStr, pathStr, draggerStr;
       std::vector<double> initialTranslation{3};
@@ -76,6 +81,8 @@ namespace OpenMBV {
       void openHDF5File() override;
       H5::VectorSerie<double>* data{nullptr};
       std::weak_ptr<CompoundRigidBody> compound;
+      std::shared_ptr<RigidBodyTable> table; // the table of the parent group, if consolidated
+      int tableIndex{0}; // the index of this body in table
 
       RigidBody();
       ~RigidBody() override;
@@ -144,21 +151,60 @@ namespace OpenMBV {
       /** Append a data vector the the h5 datsset */
       template<typename T>
       void append(const T& row) {
-        if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
         if(row.size()!=8) throw std::runtime_error("the dimension does not match");
-        if(!std::isnan(dynamicColor))
-        {
-          std::vector<double> tmprow(8);
-          std::copy(&row[0], &row[8], tmprow.begin());
-          tmprow[7]=dynamicColor;
-          data->append(tmprow);
+        if(table) { table->append(tableIndex, &row[0], dynamicColor); return; }
+        if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
+        writeRowsWithDynamicColor(data, 1, 8, &row[0], 7);
+      }
+
+      /** Append numRows rows of n values each stored row major in rows (n must be 8).
+       * All rows are written using a single extension of the HDF5 dataset and a single write which is much
+       * faster than calling append for each row. The dynamic color is applied to all rows as in append. */
+      void appendRows(int numRows, int n, const double *rows) {
+        if(n!=8 || numRows<0) throw std::runtime_error("the dimension does not match");
+        if(table) {
+          for(int r=0; r<numRows; r++)
+            table->append(tableIndex, &rows[r*8], dynamicColor);
+          return;
         }
-        else
-          data->append(row);
+        if(data==nullptr) throw std::runtime_error("can not append data to an environment object");
+        writeRowsWithDynamicColor(data, numRows, 8, rows, 7);
       }
 
-      int getRows() override { return data?data->getRows():0; }
-      std::vector<double> getRow(int i) override { return data?data->getRow(i):std::vector<double>(8); }
+      /** Append numRows rows stored row major in rows (see appendRows(int, int, const double*)) */
+      template<typename T>
+      void appendRows(int numRows, const T& rows) {
+        if(numRows<=0 || rows.size()%numRows!=0) throw std::runtime_error("the dimension does not match");
+        appendRows(numRows, rows.size()/numRows, &rows[0]);
+      }
+
+      int getRows() override { openHDF5FileIfPending(); return table?table->getRows():data?readRows(data):0; }
+      std::vector<double> getRow(int i) override {
+        std::vector<double> row(8);
+        getRow(i, 8, row.data());
+        return row;
+      }
+      void getRow(int i, int n, double *row) override {
+        openHDF5FileIfPending();
+        if(table) {
+          double tmp[8];
+          table->getRow(tableIndex, i, tmp);
+          std::copy_n(tmp, std::min(n, 8), row);
+          std::fill(row+std::min(n, 8), row+n, 0);
+        }
+        else if(data) readRow(data, i, n, row);
+        else std::fill_n(row, n, 0);
+      }
+      bool prefetchRows(int i, int numRows) override {
+        return table?table->prefetch(i, numRows):DynamicColoredBody::prefetchRows(i, numRows);
+      }
+
+      void getColumns(int firstRow, int numRows, int firstColumn, int numColumns, double *values) override {
+        openHDF5FileIfPending();
+        if(table) table->getColumns(tableIndex, firstRow, numRows, firstColumn, numColumns, values);
+        else if(data) readColumns(data, firstRow, numRows, firstColumn, numColumns, values);
+        else std::fill_n(values, numRows*numColumns, 0);
+      }
 
       /** Initializes the time invariant part of the object using a XML node */
       void initializeUsingXML(xercesc::DOMElement *element) override;
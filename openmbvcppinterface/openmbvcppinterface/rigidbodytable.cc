@@ -0,0 +1,163 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "config.h"
+#include <openmbvcppinterface/rigidbodytable.h>
+#include <openmbvcppinterface/asyncwriter.h>
+#include <openmbvcppinterface/group.h>
+#include <hdf5serie/group.h>
+#include <fmatvec/atom.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace OpenMBV {
+
+RigidBodyTable::RigidBodyTable(H5::GroupBase *group, const vector<string> &names, int compression, int chunkRows) :
+  numBodies(names.size()), frame(columns()), appended(numBodies, false) {
+  // use the defaults of hdf5serie if nothing is set (see Body::createDataHDF5)
+  if(compression<0 && chunkRows<=0)
+    data=group->createChildObject<H5::VectorSerie<double> >("rigidbodies")(columns());
+  else
+    data=group->createChildObject<H5::VectorSerie<double> >("rigidbodies")(columns(),
+      compression<0 ? Group::defaultCompression : compression, chunkRows<=0 ? Group::defaultChunkRows : chunkRows);
+  vector<string> label;
+  label.emplace_back("Time");
+  for(auto &name : names)
+    for(auto c : {"x", "y", "z", "alpha", "beta", "gamma", "color"})
+      label.emplace_back(name+" "+c);
+  data->setColumnLabel(label);
+}
+
+RigidBodyTable::RigidBodyTable(H5::GroupBase *group, int numBodies_) : numBodies(numBodies_) {
+  data=group->openChildObject<H5::VectorSerie<double> >("rigidbodies");
+  if(static_cast<int>(data->getColumns())!=columns())
+    throw runtime_error("The dataset 'rigidbodies' does not match the number of rigid bodies in the group.");
+}
+
+bool RigidBodyTable::exists(H5::GroupBase *group) {
+  return H5Lexists(group->getID(), "rigidbodies", H5P_DEFAULT)>0;
+}
+
+void RigidBodyTable::append(int index, const double *row, double dynamicColor) {
+  // the body appends a new row before all other bodies appended: write the incomplete frame
+  if(appended[index])
+    flush();
+  if(numAppended==0)
+    frame[0]=row[0];
+  else if(row[0]!=frame[0] && !timeWarned) {
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Warn)<<"The rigid bodies of a group with consolidated rigid bodies append "
+      "different times to the same row ("<<frame[0]<<" and "<<row[0]<<"). The time of the first body is used. "
+      "(This warning is printed only once.)"<<endl;
+    timeWarned=true;
+  }
+  copy_n(row+1, 7, &frame[1+7*index]);
+  if(!std::isnan(dynamicColor))
+    frame[7+7*index]=dynamicColor;
+  appended[index]=true;
+  numAppended++;
+  if(numAppended==numBodies)
+    flush();
+}
+
+void RigidBodyTable::flush() {
+  if(numAppended==0)
+    return;
+  // the rows of the bodies not appended are kept from the previous frame
+  if(numAppended<numBodies && !incompleteWarned) {
+    fmatvec::Atom::msgStatic(fmatvec::Atom::Warn)<<"A row of a group with consolidated rigid bodies is written before "
+      "all rigid bodies have appended to it: "<<numBodies-numAppended<<" of "<<numBodies<<" bodies keep the values of "
+      "the previous row. (This warning is printed only once.)"<<endl;
+    incompleteWarned=true;
+  }
+  if(asyncWriter)
+    asyncWriter->push(data, 1, columns(), frame.data());
+  else {
+    scoped_lock lock(RowCache::getHDF5Mutex());
+    AsyncWriter::appendHyperslab(data, 1, columns(), frame.data());
+  }
+  fill(appended.begin(), appended.end(), false);
+  numAppended=0;
+}
+
+int RigidBodyTable::getRows() {
+  scoped_lock lock(RowCache::getHDF5Mutex());
+  return data->getRows();
+}
+
+void RigidBodyTable::getRow(int index, int i, double *row) {
+  if(RowCache::getMemoryBudget()>0) {
+    RowCache *cache;
+    {
+      scoped_lock lock(mutex);
+      if(!rowCache)
+        rowCache=make_unique<RowCache>(data);
+      cache=rowCache.get();
+    }
+    cache->getColumns(i, 0, 1, row);
+    cache->getColumns(i, 1+7*index, 7, row+1);
+    return;
+  }
+
+  // without row cache: read the whole frame once for all bodies
+  scoped_lock lock(mutex);
+  if(bufferFrame!=i) {
+    buffer.resize(columns());
+    scoped_lock hdf5Lock(RowCache::getHDF5Mutex());
+    data->getRow(i, columns(), buffer.data());
+    bufferFrame=i;
+  }
+  row[0]=buffer[0];
+  copy_n(&buffer[1+7*index], 7, row+1);
+}
+
+void RigidBodyTable::getColumns(int index, int firstRow, int numRows, int firstColumn, int numColumns, double *values) {
+  if(numRows<=0 || numColumns<=0)
+    return;
+  scoped_lock lock(RowCache::getHDF5Mutex());
+  if(firstColumn>0) {
+    RowCache::readHyperslab(data, firstRow, numRows, 7*index+firstColumn, numColumns, values);
+    return;
+  }
+  // the time column is not next to the columns of the body
+  vector<double> time(numRows);
+  RowCache::readHyperslab(data, firstRow, numRows, 0, 1, time.data());
+  vector<double> body(numRows*(numColumns-1));
+  if(numColumns>1)
+    RowCache::readHyperslab(data, firstRow, numRows, 1+7*index, numColumns-1, body.data());
+  for(int r=0; r<numRows; r++) {
+    values[r*numColumns]=time[r];
+    copy_n(&body[r*(numColumns-1)], numColumns-1, &values[r*numColumns+1]);
+  }
+}
+
+bool RigidBodyTable::prefetch(int i, int numRows) {
+  RowCache *cache;
+  {
+    scoped_lock lock(mutex);
+    cache=rowCache.get();
+  }
+  if(!cache || RowCache::getMemoryBudget()==0)
+    return false;
+  return cache->prefetch(i, numRows);
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+   OpenMBV - Open Multi Body Viewer.
+   Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+   */
+
+
+#ifndef _OPENMBV_RIGIDBODYTABLE_H_
+#define _OPENMBV_RIGIDBODYTABLE_H_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <hdf5serie/vectorserie.h>
+#include <openmbvcppinterface/rowcache.h>
+
+namespace H5 {
+  class GroupBase;
+}
+
+namespace OpenMBV {
+
+  class AsyncWriter;
+
+  /** The data of all rigid bodies of a Group stored in a single dataset "rigidbodies" (see Group::setConsolidateRigidBodies).
+   * Each row of the dataset is one frame: the time followed by the 7 columns x, y, z, alpha, beta, gamma and color of
+   * each rigid body. The bodies are numbered by their order in the Group.
+   * A frame is written if all bodies have appended their row. If a body appends a second row before all other bodies
+   * have appended, the incomplete frame is written with the values of the previous frame for the missing bodies.
+   * The time of a frame is the time of the first body appending to it. Hence all bodies should append their rows in the
+   * same order and with the same time, since getRows of each body returns the number of frames. A warning is printed
+   * (once per table) if an incomplete frame is written or if the bodies append different times to a frame.
+   * Reading uses the row cache, if enabled, or a buffer of the last read frame. In both cases a single read fetches the
+   * data of all bodies of a frame. */
+  class RigidBodyTable {
+    public:
+      /** Create the dataset "rigidbodies" in group for the bodies names */
+      RigidBodyTable(H5::GroupBase *group, const std::vector<std::string> &names, int compression, int chunkRows);
+      /** Open the dataset "rigidbodies" of group for numBodies bodies */
+      RigidBodyTable(H5::GroupBase *group, int numBodies);
+
+      /** Returns true if group contains the dataset "rigidbodies" */
+      static bool exists(H5::GroupBase *group);
+
+      /** Set the row of body index (8 values: time and the 7 columns of the body) in the current frame.
+       * If dynamicColor is not NaN the color of the row is overwritten with it. */
+      void append(int index, const double *row, double dynamicColor);
+      /** Write the current frame even if not all bodies have appended their row */
+      void flush();
+      void setAsyncWriter(AsyncWriter *writer) { asyncWriter=writer; }
+
+      int getRows();
+      /** Copy the row i of body index (8 values: time and the 7 columns of the body) to row */
+      void getRow(int index, int i, double *row);
+      /** Copy the columns firstColumn to firstColumn+numColumns-1 (of the 8 columns of the body) of the rows firstRow to
+       * firstRow+numRows-1 of body index to values (row major) */
+      void getColumns(int index, int firstRow, int numRows, int firstColumn, int numColumns, double *values);
+      /** See Body::prefetchRows */
+      bool prefetch(int i, int numRows);
+    private:
+      H5::VectorSerie<double> *data;
+      int numBodies;
+      AsyncWriter *asyncWriter{nullptr};
+      // writer
+      std::vector<double> frame; // the current frame
+      std::vector<bool> appended; // true if the body has appended its row to the current frame
+      int numAppended{0};
+      bool incompleteWarned{false}, timeWarned{false};
+      // reader
+      std::mutex mutex; // locks all members used by the reader
+      std::unique_ptr<RowCache> rowCache;
+      int bufferFrame{-1}; // the row of the dataset stored in buffer
+      std::vector<double> buffer;
+
+      int columns() const { return 1+7*numBodies; }
+  };
+
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "config.h"
+#include <openmbvcppinterface/rowcache.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace OpenMBV {
+
+namespace {
+  // a larger block does not speed up reading significantly but costs memory
+  constexpr size_t maxBlockBytes=64*1024;
+}
+
+atomic<size_t> RowCache::memoryBudget{0};
+atomic<size_t> RowCache::numberOfCaches{0};
+atomic<size_t> RowCache::generation{0};
+mutex RowCache::hdf5Mutex;
+
+// the share of each cache changes with the number of caches: all caches recalculate their size on the next access
+RowCache::RowCache(H5::VectorSerie<double> *data_) : data(data_) {
+  numberOfCaches++;
+  generation++;
+}
+
+RowCache::~RowCache() {
+  numberOfCaches--;
+  generation++;
+}
+
+void RowCache::init() {
+  initGeneration=generation;
+  if(blockRows==0) {
+    hsize_t dims[2]={0, 0};
+    {
+      scoped_lock lock(hdf5Mutex);
+      hid_t space=H5Dget_space(data->getID());
+      if(space<0)
+        throw runtime_error("Unable to get the dataspace of a HDF5 dataset.");
+      H5Sget_simple_extent_dims(space, dims, nullptr);
+      H5Sclose(space);
+    }
+    columns=max(static_cast<int>(dims[1]), 1);
+  }
+
+  // distribute the memory budget evenly over all caches (the budget may be exceeded by the two blocks which are always allowed)
+  size_t rowBytes=columns*sizeof(double);
+  size_t cacheBytes=memoryBudget/max<size_t>(numberOfCaches, 1);
+  size_t blockBytes=min(maxBlockBytes, cacheBytes/2);
+  int newBlockRows=static_cast<int>(max<size_t>(blockBytes/rowBytes, 1));
+  maxBlocks=max<size_t>(cacheBytes/(newBlockRows*rowBytes), 2);
+  // keep the most recently used blocks which still fit if the block size is unchanged
+  if(newBlockRows!=blockRows)
+    blocks.clear();
+  blockRows=newBlockRows;
+  while(blocks.size()>maxBlocks)
+    blocks.pop_back();
+}
+
+void RowCache::clear() {
+  scoped_lock lock(mutex);
+  blocks.clear();
+  blockRows=0;
+}
+
+RowCache::Block* RowCache::find(int index, int row) {
+  for(auto it=blocks.begin(); it!=blocks.end(); ++it)
+    if(it->index==index && row-index*blockRows<it->rows) {
+      blocks.splice(blocks.begin(), blocks, it); // mark as most recently used
+      return &blocks.front();
+    }
+  return nullptr;
+}
+
+RowCache::Block& RowCache::read(int index) {
+  scoped_lock lock(hdf5Mutex);
+  // remove a (partial) block with the same index
+  blocks.remove_if([index](const Block &b){ return b.index==index; });
+  // reuse the least recently used block if the cache is full (this also reuses its memory) or create a new one
+  if(blocks.size()>=maxBlocks)
+    blocks.splice(blocks.begin(), blocks, prev(blocks.end()));
+  else
+    blocks.emplace_front();
+  Block &b=blocks.front();
+  int first=index*blockRows;
+  b.index=index;
+  b.rows=max(min(blockRows, data->getRows()-first), 0);
+  b.values.resize(b.rows*columns);
+  if(b.rows==0)
+    return b;
+
+  // read all rows of the block using a single hyperslab read
+  try {
+    readHyperslab(data, first, b.rows, 0, columns, b.values.data());
+  }
+  catch(...) {
+    blocks.pop_front();
+    throw;
+  }
+  return b;
+}
+
+void RowCache::readHyperslab(H5::VectorSerie<double> *data, int firstRow, int numRows, int firstColumn, int numColumns, double *values) {
+  hid_t dataset=data->getID();
+  hid_t fileSpace=H5Dget_space(dataset);
+  if(fileSpace<0)
+    throw runtime_error("Unable to get the dataspace of a HDF5 dataset.");
+  hsize_t start[2]={static_cast<hsize_t>(firstRow), static_cast<hsize_t>(firstColumn)};
+  hsize_t count[2]={static_cast<hsize_t>(numRows), static_cast<hsize_t>(numColumns)};
+  herr_t err=H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+  hid_t memSpace=H5Screate_simple(2, count, nullptr);
+  if(err>=0)
+    err=H5Dread(dataset, H5T_NATIVE_DOUBLE, memSpace, fileSpace, H5P_DEFAULT, values);
+  H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+  if(err<0)
+    throw runtime_error("Unable to read rows "+to_string(firstRow)+" to "+to_string(firstRow+numRows-1)+
+                        " from a HDF5 dataset.");
+}
+
+void RowCache::getRow(int i, int n, double *row) {
+  getColumns(i, 0, n, row);
+}
+
+void RowCache::getColumns(int i, int firstColumn, int n, double *values) {
+  scoped_lock lock(mutex);
+  if(blockRows==0 || initGeneration!=generation) init();
+  int index=i/blockRows;
+  Block *b=find(index, i);
+  if(!b) b=&read(index);
+  int r=i-index*blockRows;
+  if(r>=b->rows || firstColumn+n>columns) { // invalid row or size: let hdf5serie handle (and report) this
+    scoped_lock hdf5Lock(hdf5Mutex);
+    if(firstColumn==0)
+      data->getRow(i, n, values);
+    else
+      readHyperslab(data, i, 1, firstColumn, n, values);
+    return;
+  }
+  copy_n(&b->values[r*columns+firstColumn], n, values);
+}
+
+bool RowCache::prefetch(int i, int numRows) {
+  scoped_lock lock(mutex);
+  if(blockRows==0 || initGeneration!=generation) init();
+  int rows;
+  {
+    scoped_lock hdf5Lock(hdf5Mutex);
+    rows=data->getRows();
+  }
+  if(rows==0)
+    return false;
+  i=min(max(i, 0), rows-1);
+  int last=min(max(i+numRows, 0), rows-1);
+  int step=last>=i ? 1 : -1;
+  // never prefetch more blocks than the cache can hold, this would drop the blocks needed now
+  int index=i/blockRows;
+  for(size_t n=0; n<maxBlocks; n++, index+=step) {
+    if(!find(index, min((index+1)*blockRows, rows)-1)) {
+      read(index);
+      return true;
+    }
+    if(index==last/blockRows)
+      break;
+  }
+  return false;
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+   OpenMBV - Open Multi Body Viewer.
+   Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+   */
+
+
+#ifndef _OPENMBV_ROWCACHE_H_
+#define _OPENMBV_ROWCACHE_H_
+
+#include <vector>
+#include <list>
+#include <cstddef>
+#include <mutex>
+#include <atomic>
+#include <hdf5serie/vectorserie.h>
+
+namespace OpenMBV {
+
+  /** A cache of blocks of consecutive rows of a H5::VectorSerie.
+   * Each block is read from the HDF5 file using a single hyperslab read instead of one read per row.
+   * All row caches share a global memory budget (see setMemoryBudget) which is evenly distributed over all
+   * existing caches (the share of each cache is recalculated whenever a cache is created or deleted).
+   * The least recently used blocks are dropped if the budget of a cache is exceeded.
+   * The row cache is used by Body::getRow(int, int, double*) if the memory budget is not 0.
+   * getRow and prefetch may be called concurrently from different threads (e.g. prefetch from a background thread).
+   * All HDF5 reads of all row caches are serialized using hdf5Mutex since the HDF5 library may not be thread safe.
+   */
+  class RowCache {
+    public:
+      RowCache(H5::VectorSerie<double> *data_);
+      ~RowCache();
+
+      /** Copy row i (n columns) to row.
+       * The block containing row i is read from the HDF5 file if it is not already cached. */
+      void getRow(int i, int n, double *row);
+
+      /** Copy the columns firstColumn to firstColumn+n-1 of row i to values (see getRow) */
+      void getColumns(int i, int firstColumn, int n, double *values);
+
+      /** Read the first not already cached block of rows in the range from row i to row i+numRows.
+       * numRows may be negative to prefetch backwards. At most one block is read per call.
+       * Returns true if a block was read and false if the range is already cached completely. */
+      bool prefetch(int i, int numRows);
+
+      /** Remove all cached rows. */
+      void clear();
+
+      /** Returns the dataset cached by this object */
+      H5::VectorSerie<double>* getVectorSerie() { return data; }
+
+      /** Set the memory budget in bytes for all row caches. 0 disables the row cache.
+       * All existing caches are resized on the next access. */
+      static void setMemoryBudget(size_t bytes) { memoryBudget=bytes; generation++; }
+
+      static size_t getMemoryBudget() { return memoryBudget; }
+
+      /** The mutex locked by all row caches during HDF5 calls.
+       * Other code calling HDF5 while a prefetch may run in another thread must lock this mutex too. */
+      static std::mutex& getHDF5Mutex() { return hdf5Mutex; }
+
+      /** Read the columns firstColumn to firstColumn+numColumns-1 of the rows firstRow to firstRow+numRows-1
+       * of data to values (row major) using a single hyperslab read.
+       * The caller must lock getHDF5Mutex(). */
+      static void readHyperslab(H5::VectorSerie<double> *data, int firstRow, int numRows, int firstColumn, int numColumns,
+                                double *values);
+    private:
+      struct Block {
+        int index; // the block number: the first row of this block is index*blockRows
+        int rows; // number of valid rows of this block (the last block of a growing dataset may be partial)
+        std::vector<double> values; // row major values of all rows of this block
+      };
+      H5::VectorSerie<double> *data;
+      int columns{0};
+      int blockRows{0}; // 0 = not initialized
+      size_t initGeneration{0}; // the value of generation when init was called (the size must be recalculated if changed)
+      size_t maxBlocks{2};
+      std::list<Block> blocks; // the most recently used block is the first one
+      std::mutex mutex; // locks all members of this object
+
+      void init();
+      Block* find(int index, int row);
+      Block& read(int index);
+
+      static std::atomic<size_t> memoryBudget;
+      static std::atomic<size_t> numberOfCaches;
+      static std::atomic<size_t> generation;
+      static std::mutex hdf5Mutex;
+  };
+
+}
+
+#endif
@@ -49,7 +49,7 @@ DOMElement* SpineExtrusion::writeXMLFile(DOMNode *parent) {
 
 void SpineExtrusion::createHDF5File() {
   DynamicColoredBody::createHDF5File();
-  data=hdf5Group->createChildObject<H5::VectorSerie<double> >("data")(1+4*numberOfSpinePoints);
+  data=createDataHDF5(1+4*numberOfSpinePoints);
   vector<string> columns;
   columns.emplace_back("Time");
   for(int i=0;i<numberOfSpinePoints;i++) {
@@ -64,13 +64,7 @@ void SpineExtrusion::createHDF5File() {
 void SpineExtrusion::openHDF5File() {
   DynamicColoredBody::openHDF5File();
   if(!hdf5Group) return;
-  try {
-    data=hdf5Group->openChildObject<H5::VectorSerie<double> >("data");
-  }
-  catch(...) {
-    data=nullptr;
-    msg(Debug)<<"Unable to open the HDF5 Dataset 'data'. Using 0 for all data."<<endl;
-  }
+  data=openDataHDF5();
 }
 
 void SpineExtrusion::initializeUsingXML(DOMElement *element) {
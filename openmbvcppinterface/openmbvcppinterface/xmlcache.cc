@@ -0,0 +1,291 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "config.h"
+#include <openmbvcppinterface/xmlcache.h>
+#include <mbxmlutilshelper/dom.h>
+#include <xercesc/dom/DOMDocument.hpp>
+#include <xercesc/dom/DOMElement.hpp>
+#include <xercesc/dom/DOMAttr.hpp>
+#include <xercesc/dom/DOMNamedNodeMap.hpp>
+#include <xercesc/dom/DOMText.hpp>
+#include <xercesc/dom/DOMCDATASection.hpp>
+#include <xercesc/dom/DOMProcessingInstruction.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+using namespace std;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace OpenMBV {
+
+boost::filesystem::path XMLCache::directory;
+
+namespace {
+
+  // increment if the format changes
+  const char magic[]="OMBVXC01";
+
+  // the embed data of MBXMLUtils which is stored (the embed data cannot be enumerated)
+  const vector<string> embedDataNames {
+    "MBXMLUtils_OriginalFilename",
+    "MBXMLUtils_LineNr",
+    "MBXMLUtils_EmbedCountNr",
+    "MBXMLUtils_EmbedXPathCount",
+    "MBXMLUtils_OriginalElementLineNr",
+  };
+
+  // a null terminated XMLCh string
+  using XString = vector<XMLCh>;
+
+  struct Writer {
+    string buf;
+    template<typename T>
+    void put(T v) { buf.append(reinterpret_cast<const char*>(&v), sizeof(T)); }
+    void putStr(const string &s) { put<uint32_t>(s.size()); buf.append(s); }
+    void putXStr(const XMLCh *s) {
+      uint32_t len=s ? XMLString::stringLen(s) : 0;
+      put(len);
+      buf.append(reinterpret_cast<const char*>(s), len*sizeof(XMLCh));
+    }
+  };
+
+  struct Reader {
+    const char *p, *end;
+    template<typename T>
+    T get() {
+      if(end-p<static_cast<ptrdiff_t>(sizeof(T))) throw runtime_error("truncated cache file");
+      T v;
+      memcpy(&v, p, sizeof(T));
+      p+=sizeof(T);
+      return v;
+    }
+    string getStr() {
+      auto len=get<uint32_t>();
+      if(static_cast<size_t>(end-p)<len) throw runtime_error("truncated cache file");
+      string s(p, len);
+      p+=len;
+      return s;
+    }
+    XString getXStr() {
+      auto len=get<uint32_t>();
+      if(static_cast<size_t>(end-p)<len*sizeof(XMLCh)) throw runtime_error("truncated cache file");
+      XString s(len+1, 0);
+      memcpy(s.data(), p, len*sizeof(XMLCh));
+      p+=len*sizeof(XMLCh);
+      return s;
+    }
+  };
+
+  // the size and modification time of a file
+  void putStamp(Writer &w, const boost::filesystem::path &file) {
+    std::filesystem::path f(file.string());
+    w.putStr(file.string());
+    w.put<uint64_t>(std::filesystem::file_size(f));
+    w.put<int64_t>(std::filesystem::last_write_time(f).time_since_epoch().count());
+  }
+
+  bool checkStamp(Reader &r) {
+    std::filesystem::path f(r.getStr());
+    auto size=r.get<uint64_t>();
+    auto mtime=r.get<int64_t>();
+    error_code ec;
+    auto curSize=std::filesystem::file_size(f, ec);
+    if(ec) return false;
+    auto curMTime=std::filesystem::last_write_time(f, ec);
+    if(ec) return false;
+    return curSize==size && curMTime.time_since_epoch().count()==mtime;
+  }
+
+  const XMLCh* nullIfEmpty(const XString &s) { return s.size()<=1 ? nullptr : s.data(); }
+
+  void writeNode(Writer &w, const DOMNode *n) {
+    switch(n->getNodeType()) {
+      case DOMNode::ELEMENT_NODE: {
+        auto e=static_cast<const DOMElement*>(n);
+        w.put<char>('E');
+        w.putXStr(e->getNamespaceURI());
+        w.putXStr(e->getTagName());
+        auto *attrs=e->getAttributes();
+        w.put<uint32_t>(attrs->getLength());
+        for(XMLSize_t i=0; i<attrs->getLength(); i++) {
+          auto a=static_cast<const DOMAttr*>(attrs->item(i));
+          w.putXStr(a->getNamespaceURI());
+          w.putXStr(a->getName());
+          w.putXStr(a->getValue());
+        }
+        vector<pair<uint8_t, string>> embed;
+        for(size_t i=0; i<embedDataNames.size(); i++) {
+          auto v=E(e)->getEmbedData(embedDataNames[i]);
+          if(!v.empty())
+            embed.emplace_back(i, v);
+        }
+        w.put<uint8_t>(embed.size());
+        for(auto &[i, v] : embed) {
+          w.put(i);
+          w.putStr(v);
+        }
+        uint32_t numChilds=0;
+        for(auto c=e->getFirstChild(); c; c=c->getNextSibling())
+          if(c->getNodeType()!=DOMNode::COMMENT_NODE) numChilds++;
+        w.put(numChilds);
+        for(auto c=e->getFirstChild(); c; c=c->getNextSibling())
+          if(c->getNodeType()!=DOMNode::COMMENT_NODE)
+            writeNode(w, c);
+        break;
+      }
+      case DOMNode::TEXT_NODE:
+        w.put<char>('T');
+        w.putXStr(static_cast<const DOMText*>(n)->getData());
+        break;
+      case DOMNode::CDATA_SECTION_NODE:
+        w.put<char>('C');
+        w.putXStr(static_cast<const DOMCDATASection*>(n)->getData());
+        break;
+      case DOMNode::PROCESSING_INSTRUCTION_NODE:
+        w.put<char>('P');
+        w.putXStr(static_cast<const DOMProcessingInstruction*>(n)->getTarget());
+        w.putXStr(static_cast<const DOMProcessingInstruction*>(n)->getData());
+        break;
+      default:
+        throw runtime_error("unsupported DOM node type");
+    }
+  }
+
+  DOMNode* readNode(Reader &r, DOMDocument *doc) {
+    switch(r.get<char>()) {
+      case 'E': {
+        auto ns=r.getXStr();
+        auto name=r.getXStr();
+        DOMElement *e=doc->createElementNS(nullIfEmpty(ns), name.data());
+        auto numAttrs=r.get<uint32_t>();
+        for(uint32_t i=0; i<numAttrs; i++) {
+          auto attrNS=r.getXStr();
+          auto attrName=r.getXStr();
+          auto value=r.getXStr();
+          e->setAttributeNS(nullIfEmpty(attrNS), attrName.data(), value.data());
+        }
+        auto numEmbed=r.get<uint8_t>();
+        for(uint8_t i=0; i<numEmbed; i++) {
+          auto idx=r.get<uint8_t>();
+          if(idx>=embedDataNames.size()) throw runtime_error("invalid cache file");
+          E(e)->addEmbedData(embedDataNames[idx], r.getStr());
+        }
+        auto numChilds=r.get<uint32_t>();
+        for(uint32_t i=0; i<numChilds; i++)
+          e->appendChild(readNode(r, doc));
+        return e;
+      }
+      case 'T':
+        return doc->createTextNode(r.getXStr().data());
+      case 'C':
+        return doc->createCDATASection(r.getXStr().data());
+      case 'P': {
+        auto target=r.getXStr();
+        return doc->createProcessingInstruction(target.data(), r.getXStr().data());
+      }
+      default:
+        throw runtime_error("invalid cache file");
+    }
+  }
+
+}
+
+boost::filesystem::path XMLCache::cacheFile(const boost::filesystem::path &xmlFile) {
+  stringstream str;
+  str<<hex<<hash<string>()(boost::filesystem::absolute(xmlFile).string())<<".ombvxc";
+  return directory/str.str();
+}
+
+shared_ptr<DOMDocument> XMLCache::load(const shared_ptr<DOMParser> &parser, const boost::filesystem::path &xmlFile) {
+  if(directory.empty())
+    return nullptr;
+  try {
+    ifstream f(cacheFile(xmlFile).string(), ios::binary);
+    if(!f)
+      return nullptr;
+    string buf((istreambuf_iterator<char>(f)), istreambuf_iterator<char>());
+    Reader r{buf.data(), buf.data()+buf.size()};
+    if(buf.compare(0, sizeof(magic)-1, magic)!=0)
+      return nullptr;
+    r.p+=sizeof(magic)-1;
+    // the hash of the file name may not be unique
+    if(r.getStr()!=boost::filesystem::absolute(xmlFile).string())
+      return nullptr;
+    // the XML file and all included files must be unchanged
+    auto numFiles=r.get<uint32_t>();
+    for(uint32_t i=0; i<numFiles; i++)
+      if(!checkStamp(r))
+        return nullptr;
+
+    shared_ptr<DOMDocument> doc=parser->createDocument();
+    doc->setDocumentURI(X()%(string("mbxmlutilsfile://").append(xmlFile.string())));
+    doc->appendChild(readNode(r, doc.get()));
+    return doc;
+  }
+  catch(...) {
+    // a invalid cache file is just ignored (and rewritten by the caller)
+    return nullptr;
+  }
+}
+
+bool XMLCache::save(DOMDocument *doc, const boost::filesystem::path &xmlFile, const vector<boost::filesystem::path> &dependencies) {
+  if(directory.empty())
+    return false;
+  string tmpFile;
+  try {
+    Writer w;
+    w.buf.append(magic, sizeof(magic)-1);
+    w.putStr(boost::filesystem::absolute(xmlFile).string());
+    w.put<uint32_t>(1+dependencies.size());
+    putStamp(w, xmlFile);
+    for(auto &d : dependencies)
+      putStamp(w, d);
+    writeNode(w, doc->getDocumentElement());
+
+    // write to a temporary file and rename it: a concurrent reader never sees a partial file
+    std::filesystem::create_directories(directory.string());
+    auto file=cacheFile(xmlFile);
+    tmpFile=file.string()+"."+to_string(chrono::steady_clock::now().time_since_epoch().count());
+    {
+      ofstream f(tmpFile, ios::binary);
+      f.write(w.buf.data(), w.buf.size());
+      if(!f)
+        throw runtime_error("write failed");
+    }
+    std::filesystem::rename(tmpFile, file.string());
+    return true;
+  }
+  catch(...) {
+    error_code ec;
+    if(!tmpFile.empty())
+      std::filesystem::remove(tmpFile, ec);
+    return false;
+  }
+}
+
+}
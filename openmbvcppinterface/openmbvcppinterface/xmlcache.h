@@ -0,0 +1,60 @@
+/*
+   OpenMBV - Open Multi Body Viewer.
+   Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+   */
+
+
+#ifndef _OPENMBV_XMLCACHE_H_
+#define _OPENMBV_XMLCACHE_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mbxmlutilshelper/dom.h>
+
+namespace OpenMBV {
+
+  /** A binary cache of parsed .ombvx files.
+   * Parsing a large .ombvx file (including its XIncludes) with xerces takes long. Group::read stores the DOM tree of
+   * a parsed file in a compact binary file in the cache directory and, on the next read of the unchanged file, creates
+   * the DOM tree from this file without parsing the XML. A cache file is valid if the size and the modification time
+   * of the .ombvx file and of all included files are unchanged.
+   * The cache stores elements, attributes, text, processing instructions and the embed data of MBXMLUtils. Comments
+   * and the XML line numbers (only needed for error messages) are not restored. */
+  class XMLCache {
+    public:
+      /** Set the directory of the cache files. The cache is disabled if dir is empty (the default). */
+      static void setDirectory(const boost::filesystem::path &dir) { directory=dir; }
+      static const boost::filesystem::path& getDirectory() { return directory; }
+
+      /** Create the DOM tree of xmlFile from the cache using parser. Returns nullptr if the cache is disabled or if
+       * no valid cache file exists. */
+      static std::shared_ptr<xercesc::DOMDocument> load(const std::shared_ptr<MBXMLUtils::DOMParser> &parser,
+                                                                    const boost::filesystem::path &xmlFile);
+
+      /** Store the DOM tree doc parsed from xmlFile in the cache. dependencies are the files included by xmlFile.
+       * Returns false if the cache is disabled or the cache file cannot be written. */
+      static bool save(xercesc::DOMDocument *doc, const boost::filesystem::path &xmlFile,
+                       const std::vector<boost::filesystem::path> &dependencies);
+    private:
+      static boost::filesystem::path directory;
+      static boost::filesystem::path cacheFile(const boost::filesystem::path &xmlFile);
+  };
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+/*
+    OpenMBV - Open Multi Body Viewer.
+    Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+*/
+
+
+#include "config.h"
+#include <openmbvcppinterface/xmlstreamwriter.h>
+#include <openmbvcppinterface/object.h>
+#include <xercesc/dom/DOMImplementation.hpp>
+#include <xercesc/dom/DOMImplementationRegistry.hpp>
+#include <xercesc/dom/DOMLSSerializer.hpp>
+#include <xercesc/dom/DOMLSOutput.hpp>
+#include <xercesc/dom/DOMConfiguration.hpp>
+#include <xercesc/dom/DOMComment.hpp>
+#include <xercesc/framework/MemBufFormatTarget.hpp>
+#include <xercesc/util/XMLUni.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+
+using namespace std;
+using namespace MBXMLUtils;
+using namespace xercesc;
+
+namespace OpenMBV {
+
+namespace {
+  // the DOM document is renewed after this number of written elements since xerces frees the memory of released
+  // nodes only when the document is released
+  constexpr int renewDocument=1000;
+
+  // marks the position of the children when writing a start tag
+  const string childMarker="<!--OPENMBV_CHILDREN-->";
+}
+
+XMLStreamWriter::XMLStreamWriter(const boost::filesystem::path &fileName_) : fileName(fileName_) {
+  // use the same lock file as DOMParser::serialize and DOMParser::parse
+  boost::filesystem::path lockFile(fileName.parent_path()/(string(".").append(fileName.filename().string()).append(".lock")));
+  { std::ofstream dummy(lockFile.string()); } // create the file
+  fileLock=make_unique<boost::interprocess::file_lock>(lockFile.string().c_str());
+  fileLock->lock();
+
+  file.open(fileName.string(), ios::binary);
+  if(!file)
+    throw runtime_error("Unable to open "+fileName.string()+" for writing.");
+  file<<"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>\n";
+
+  // the same settings as DOMParser::serialize
+  DOMImplementation *impl=DOMImplementationRegistry::getDOMImplementation(X()%"");
+  serializer.reset(impl->createLSSerializer(), [](auto &&s) { if(s) s->release(); });
+  serializer->getDomConfig()->setParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true);
+  serializer->getDomConfig()->setParameter(XMLUni::fgDOMWRTXercesPrettyPrint, false);
+  serializer->getDomConfig()->setParameter(XMLUni::fgDOMXMLDeclaration, false);
+  target=make_unique<MemBufFormatTarget>();
+  output.reset(impl->createLSOutput(), [](auto &&o) { if(o) o->release(); });
+  output->setByteStream(target.get());
+  output->setEncoding(X()%"UTF-8");
+
+  parser=DOMParser::create();
+  newDocument();
+}
+
+XMLStreamWriter::~XMLStreamWriter() {
+  if(fileLock)
+    fileLock->unlock();
+}
+
+void XMLStreamWriter::newDocument() {
+  doc=parser->createDocument();
+  parent=D(doc)->createElement(OPENMBV%"Group");
+  doc->appendChild(parent);
+  numWritten=0;
+}
+
+string XMLStreamWriter::serialize(DOMNode *n) {
+  target->reset();
+  if(!serializer->write(n, output.get()))
+    throw runtime_error("Serializing the XML element failed.");
+  string str(reinterpret_cast<const char*>(target->getRawBuffer()), target->getLen());
+  // the namespace of a element is declared on each serialized element: remove it, except on the root element
+  if(!endTags.empty()) {
+    string ns=" xmlns=\""+OPENMBV.getNamespaceURI()+"\"";
+    size_t end=str.find('>');
+    size_t pos=str.find(ns);
+    if(pos<end)
+      str.erase(pos, ns.size());
+  }
+  // trim the whitespace (pretty print) before and after the element
+  str.erase(0, str.find_first_not_of(" \n\r\t"));
+  str.erase(str.find_last_not_of(" \n\r\t")+1);
+  return str;
+}
+
+void XMLStreamWriter::write() {
+  while(DOMNode *c=parent->getFirstChild()) {
+    file<<serialize(c)<<"\n";
+    parent->removeChild(c)->release();
+    numWritten++;
+  }
+  if(numWritten>=renewDocument)
+    newDocument();
+}
+
+void XMLStreamWriter::startElement() {
+  DOMElement *e=parent->getFirstElementChild();
+  if(!e)
+    throw runtime_error("Internal error: no element to write.");
+  e->appendChild(doc->createComment(X()%childMarker.substr(4, childMarker.size()-7)));
+  string str=serialize(e);
+  parent->removeChild(e)->release();
+  size_t pos=str.find(childMarker);
+  if(pos==string::npos)
+    throw runtime_error("Internal error: child marker not found.");
+  string head=str.substr(0, pos);
+  head.erase(head.find_last_not_of(" \n\r\t")+1);
+  string tail=str.substr(pos+childMarker.size());
+  tail.erase(0, tail.find_first_not_of(" \n\r\t"));
+  file<<head<<"\n";
+  endTags.emplace_back(tail);
+}
+
+void XMLStreamWriter::endElement() {
+  file<<endTags.back()<<"\n";
+  endTags.pop_back();
+}
+
+void XMLStreamWriter::close() {
+  file.close();
+  if(!file)
+    throw runtime_error("Writing "+fileName.string()+" failed.");
+  fileLock->unlock();
+  fileLock.reset();
+}
+
+}
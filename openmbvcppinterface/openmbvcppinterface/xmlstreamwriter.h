@@ -0,0 +1,89 @@
+/*
+   OpenMBV - Open Multi Body Viewer.
+   Copyright (C) 2009 Markus Friedrich
+
+  This library is free software; you can redistribute it and/or 
+  modify it under the terms of the GNU Lesser General Public 
+  License as published by the Free Software Foundation; either 
+  version 2.1 of the License, or (at your option) any later version. 
+   
+  This library is distributed in the hope that it will be useful, 
+  but WITHOUT ANY WARRANTY; without even the implied warranty of 
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU 
+  Lesser General Public License for more details. 
+   
+  You should have received a copy of the GNU Lesser General Public 
+  License along with this library; if not, write to the Free Software 
+  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+   */
+
+
+#ifndef _OPENMBV_XMLSTREAMWRITER_H_
+#define _OPENMBV_XMLSTREAMWRITER_H_
+
+#include <string>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <mbxmlutilshelper/dom.h>
+
+namespace XERCES_CPP_NAMESPACE {
+  class DOMLSSerializer;
+  class DOMLSOutput;
+  class MemBufFormatTarget;
+}
+
+namespace boost {
+  namespace interprocess {
+    class file_lock;
+  }
+}
+
+namespace OpenMBV {
+
+  /** Write a XML file element by element with (almost) constant memory (see Group::writeXML).
+   * The elements are created by the usual writeXMLFile functions as children of getParent() and are then written
+   * to the file using write(). This way only the DOM tree of a single object is in memory and not the DOM tree
+   * of the whole file. Elements with streamed children (groups) are written using startElement and endElement.
+   * The output is the same as serializing the whole DOM tree, except the indentation of nested elements. */
+  class XMLStreamWriter {
+    public:
+      /** Open fileName for writing and write the XML declaration */
+      XMLStreamWriter(const boost::filesystem::path &fileName);
+      ~XMLStreamWriter();
+
+      /** The element to pass as parent to writeXMLFile */
+      xercesc::DOMElement* getParent() { return parent; }
+
+      /** Write all children of getParent() and remove them from getParent() */
+      void write();
+
+      /** Write the start tag and all children of the (only) child element of getParent() and remove it.
+       * Elements written afterwards are children of this element until endElement is called. */
+      void startElement();
+
+      /** Write the end tag of the element of the last startElement */
+      void endElement();
+
+      /** Finish writing. Throws if writing failed. */
+      void close();
+    private:
+      boost::filesystem::path fileName;
+      std::unique_ptr<boost::interprocess::file_lock> fileLock;
+      std::ofstream file;
+      std::shared_ptr<MBXMLUtils::DOMParser> parser;
+      std::shared_ptr<xercesc::DOMDocument> doc;
+      xercesc::DOMElement *parent;
+      std::shared_ptr<xercesc::DOMLSSerializer> serializer;
+      std::shared_ptr<xercesc::DOMLSOutput> output;
+      std::unique_ptr<xercesc::MemBufFormatTarget> target;
+      std::vector<std::string> endTags;
+      int numWritten{0};
+
+      void newDocument();
+      std::string serialize(xercesc::DOMNode *n);
+  };
+
+}
+
+#endif
@@ -55,6 +55,30 @@
   // for python std::vector<double> wrapping work well out of the box
   %template(VectorDouble) std::vector<double>;
   %template(VectorInt) std::vector<int>;
+
+  // bulk data is passed as NumPy arrays without converting each element to/from a python object
+  %{
+  #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+  #include <numpy/arrayobject.h>
+  %}
+  %init %{
+    import_array();
+  %}
+  // appendRows(rows) with rows being a 2D NumPy array (one row per line): all rows are appended with a single write.
+  // A C contiguous float64 array is used without any copy, all other arrays are converted once.
+  %typemap(typecheck, precedence=SWIG_TYPECHECK_DOUBLE_ARRAY) (int numRows, int n, const double *rows) {
+    $1=PyArray_Check($input) && PyArray_NDIM(reinterpret_cast<PyArrayObject*>($input))==2;
+  }
+  %typemap(in) (int numRows, int n, const double *rows) (PyArrayObject *array=nullptr) {
+    array=reinterpret_cast<PyArrayObject*>(PyArray_FROMANY($input, NPY_DOUBLE, 2, 2, NPY_ARRAY_IN_ARRAY));
+    if(!array) SWIG_fail;
+    $1=PyArray_DIM(array, 0);
+    $2=PyArray_DIM(array, 1);
+    $3=static_cast<const double*>(PyArray_DATA(array));
+  }
+  %typemap(freearg) (int numRows, int n, const double *rows) {
+    Py_XDECREF(array$argnum);
+  }
 #endif
 
 #ifdef SWIGOCTAVE
@@ -197,6 +221,14 @@
 
 
 
+// the caller supplied buffer variants of getRow, getColumns and appendRows are for C++ only (use getRow(int) and
+// appendRows(int, vector) from the target languages). Python maps appendRows to a 2D NumPy array, see above.
+%ignore *::getRow(int, int, double*);
+%ignore *::getColumns(int, int, int, int, double*);
+#ifndef SWIGPYTHON
+%ignore *::appendRows(int, int, const double*);
+#endif
+
 // generate interfaces for these files
 %include <openmbvcppinterface/polygonpoint.h>
 %include <openmbvcppinterface/object.h>
@@ -226,13 +258,45 @@
 %include <openmbvcppinterface/dynamicindexedlineset.h>
 %include <openmbvcppinterface/dynamicindexedfaceset.h>
 
-%extend OpenMBV::SpineExtrusion        { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::NurbsDisk             { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::Arrow                 { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::RigidBody             { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::CoilSpring            { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::Path                  { %template(append) append<std::vector<double> >; };
-%extend OpenMBV::FlexibleBody          { %template(append) append<std::vector<double> >; };
+%extend OpenMBV::SpineExtrusion        { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::NurbsDisk             { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::Arrow                 { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::RigidBody             { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::CoilSpring            { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::Path                  { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+%extend OpenMBV::FlexibleBody          { %template(append) append<std::vector<double> >; %template(appendRows) appendRows<std::vector<double> >; };
+
+#ifdef SWIGPYTHON
+  %extend OpenMBV::Body {
+    // Return the rows firstRow to firstRow+numRows-1 (all rows from firstRow if numRows<0) as a 2D NumPy array.
+    // The rows are read directly into the memory of the array.
+    PyObject* getRowsAsArray(int firstRow=0, int numRows=-1) {
+      int rows=$self->getRows();
+      if(numRows<0)
+        numRows=rows-firstRow;
+      if(firstRow<0 || numRows<0 || firstRow+numRows>rows)
+        throw std::runtime_error("the row range is out of bounds");
+      int n=rows>0 ? $self->getRow(0).size() : 0;
+      npy_intp dims[2]={numRows, n};
+      PyObject *ret=PyArray_SimpleNew(2, dims, NPY_DOUBLE);
+      if(!ret)
+        throw std::runtime_error("unable to create the NumPy array");
+      auto *data=static_cast<double*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(ret)));
+      try {
+        if(auto *rb=dynamic_cast<OpenMBV::RigidBody*>($self))
+          rb->getColumns(firstRow, numRows, 0, n, data); // a single read of all rows
+        else
+          for(int i=0; i<numRows; i++)
+            $self->getRow(firstRow+i, n, data+static_cast<size_t>(i)*n);
+      }
+      catch(...) {
+        Py_DECREF(ret);
+        throw;
+      }
+      return ret;
+    }
+  };
+#endif
 
 %include <openmbvcppinterface/objectfactory.h>
 %template(create_Group) OpenMBV::ObjectFactory::create<OpenMBV::Group>;
@@ -1,5 +1,7 @@
 import sys
 import os
+import time
+import numpy
 
 sys.path.append(os.environ['OPENMBVCPPINTERFACE_PREFIX']+"/bin") # This path must point to your MBSim-Env installation 'bin' directory
 
@@ -60,4 +62,53 @@ def createMyGroup(g):
   return cube
 
 
+# append and read many rows using NumPy arrays and python lists, check the rows read and print the throughput
+def throughput():
+  numRows=20000
+
+  group=OpenMBV.ObjectFactory.create_Group()
+  group.setName("MBS")
+  cubeList=OpenMBV.ObjectFactory.create_Cube()
+  cubeList.setName("CubeList")
+  group.addObject(cubeList)
+  cubeArray=OpenMBV.ObjectFactory.create_Cube()
+  cubeArray.setName("CubeArray")
+  group.addObject(cubeArray)
+  group.setFileName("MBS_throughput.ombvx")
+  group.write(True, True)
+
+  rows=numpy.zeros((numRows, 8))
+  rows[:,0]=numpy.arange(numRows)*1e-3
+  rows[:,1]=numpy.sin(rows[:,0])
+  rows[:,7]=0.5
+
+  start=time.perf_counter()
+  for row in rows.tolist():
+    cubeList.append(row)
+  listTime=time.perf_counter()-start
+
+  start=time.perf_counter()
+  cubeArray.appendRows(rows)
+  arrayTime=time.perf_counter()-start
+
+  # read the rows back from the (still open) file
+  start=time.perf_counter()
+  readList=numpy.array([cubeList.getRow(i) for i in range(cubeList.getRows())])
+  readListTime=time.perf_counter()-start
+
+  start=time.perf_counter()
+  readArray=cubeArray.getRowsAsArray()
+  readArrayTime=time.perf_counter()-start
+
+  print("throughput [rows/s]: append list %.0f, append array %.0f, read list %.0f, read array %.0f"%(
+    numRows/listTime, numRows/arrayTime, numRows/readListTime, numRows/readArrayTime), file=sys.stderr)
+
+  if not numpy.array_equal(readList, rows) or not numpy.array_equal(readArray, rows):
+    raise RuntimeError("The rows read differ from the rows written.")
+  if not numpy.array_equal(cubeArray.getRowsAsArray(100, 10), rows[100:110]):
+    raise RuntimeError("The row range read differs from the rows written.")
+  print("throughput OK")
+
+
 main()
+throughput()